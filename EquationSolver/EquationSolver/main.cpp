@@ -1,7 +1,23 @@
 #include <iostream>
+#include <fstream>
+#include <iomanip>
 #include <cmath>
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <functional>
 #include <exception>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <map>
+#include <cctype>
+#include <complex>
+#include <algorithm>
+#include <chrono>
 
 using namespace std;
 
@@ -11,10 +27,44 @@ using namespace std;
 #define SECANT 2
 #define FALSEP 3
 #define NEWTON 4
+#define BRENT 5
+#define HALLEY 6
+#define SCAN 7
+
+//----Polynomial Equations----------
+constexpr int POLYNOMIAL_DEGREE = 3; //Degree of the built-in polynomial equations.
+constexpr double POLYNOMIAL_COEFFICIENTS[4][POLYNOMIAL_DEGREE + 1] = { { 0 }, //Equations 1-3, from the constant term up; shared by their function objects and their Polynomial objects.
+	{ -4, 12, -8, 1 },
+	{ -12, -21, 18, -2.75 },
+	{ -2, 6, -4, 0.5 }
+};
 
 //----Stopping Criteria----------
-const double EPSILON = 0.0000001;
-const int MAX_ITERATIONS = 10000;
+constexpr double EPSILON = 0.0000001;
+constexpr int MAX_ITERATIONS = 10000;
+
+//----Lockstep Lanes----------
+const int SIMD_LANES = 8; //Problems advanced together by the multi-root solvers (one AVX-512 or two AVX2 registers).
+
+//----Parallel Sweep----------
+const int SWEEP_CHUNK = 64; //Records per stolen unit of work.
+const int BATCH_BLOCK = 1 << 16; //Records read, solved and written together in batch mode.
+
+//----User Equations----------
+const int FIRST_USER_EQUATION = 6; //IDs 1-5 are the built-in equations.
+const int EXPRESSION_REGISTERS = 16; //Registers available to a compiled expression.
+
+//----Benchmark Grid----------
+const double BENCH_FROM = -5; //First starting point (one bound for bracketing methods).
+const double BENCH_TO = 5; //Last starting point.
+const double BENCH_WIDTH = 1; //Distance to the Secant second guess, also the farthest a bracket reaches past its root.
+const int BENCH_SAMPLES = 1000; //Scan samples locating the roots that the brackets enclose.
+
+//----Continuation----------
+const double CONTINUATION_OFFSET = 0.0001; //Relative distance of the Secant second guess from the predicted root.
+
+//----Root Isolation----------
+const double ISOLATION_SPLIT = 0.4921875; //Relative position of the bisection point, off the middle so that round roots rarely land on a box edge.
 
 
 //----Exceptions Classes----------
@@ -25,432 +75,2665 @@ public:
 	}
 };
 
-class divideByZeroException : public exception {
+class invalidProblemException : public exception {
 public:
 	virtual const char* what() const throw() {
-		return "Cannot divide by zero";
+		return "Invalid equation or method ID.";
 	}
 };
 
-class logZeroException : public exception {
+class invalidExpressionException : public exception {
 public:
 	virtual const char* what() const throw() {
-		return "Cannot compute ln(0).";
+		return "Invalid or too complex equation expression.";
 	}
 };
 
 
+//----Solution Status----------
+enum SolutionStatus { //Outcome of a solve; the solvers report failures here instead of throwing.
+	SOLVED,
+	NO_ROOT,
+	NOT_CONVERGED,
+	DIVIDE_BY_ZERO,
+	DOMAIN_ERROR,
+	INVALID_PROBLEM
+};
+
 //----Solution Struct----------
 struct Solution {
-	double root;
+	double root; //NaN unless status is SOLVED.
 	double error;
 	int iterations;
+	int evaluations; //Number of function (and derivative) evaluations.
+	SolutionStatus status;
 };
 
-//----Formula Function Object----------
-typedef function<double(double)> Formula;
+//----Tolerance Struct----------
+struct Tolerance { //Stopping criteria of one solve; it stops as soon as any of the step or residual criteria is met.
+	double absolute; //Largest accepted |x(n+1) - x(n)|, which lets roots at x = 0 converge.
+	double relative; //Largest accepted |x(n+1) - x(n)| / |x(n+1)|.
+	double residual; //Largest accepted |f(x)| (0: not checked).
+	int maxIterations;
+	int maxEvaluations; //Function evaluation budget (0: unlimited).
+};
 
+const Tolerance DEFAULT_TOLERANCE = { 0, EPSILON, 0, MAX_ITERATIONS, 0 }; //The original stopping criteria.
 
-//----Helper Functions----------
-void initFormulae();
-void displayEquationsMenu();
-void displayMethodsMenu();
-void displayExitMenu();
-int getSelection(int min, int max);
+//----Problem Struct----------
+struct Problem { //Batch record: equation, method and guesses (second guess is ignored by Newton-Raphson).
+	int equation;
+	int method;
+	double guess0;
+	double guess1;
+};
 
+//----Work-Stealing Queue Class----------
+class WorkQueue { //Per-thread deque of chunk indices; the owner pops the back, thieves steal the front.
+	deque<int> chunks;
+	mutex guard;
 
-//----Root Computation Functions----------
-bool rootExists(Formula fx, double xl, double xh);
-Solution findRootByBisection(Formula fx);
-Solution findRootBySecant(Formula fx);
-Solution findRootByFalsePosition(Formula fx);
-Solution findRootByNewton(Formula fx, Formula dfx);
+public:
+	bool pop(int &chunk);
+	bool steal(int &chunk);
+	void push(int chunk);
+};
 
+//----Formula Function Object----------
+typedef function<double(double)> Formula;
 
-//----Equations' Evaluators----------
-Formula formulae[6], //Original Equations. 
-		dformulae[6]; //Derivatives Equations.
 
+//----Dual Number Struct----------
+struct Dual { //Truncated Taylor expansion: value, first and second derivatives with respect to x.
+	double value;
+	double first;
+	double second;
+	constexpr Dual(double value = 0, double first = 0, double second = 0) :value(value), first(first), second(second) {}
+};
 
-int main(int argc, char **argv) {
-	initFormulae(); //Initialize Equations' Evaluators.
-	while (1){
-		system("cls");
-		displayEquationsMenu(); //Equation Selection Menu.
-		int selectedEquation = getSelection(1, 6); //Get Selected Equation.
-		if (selectedEquation == 6)
-			exit(0);
-		
-		while (1){
-			system("cls");
-			displayMethodsMenu(); //Method Selection Menu.
-			int selectedMethod = getSelection(1, 6); //Get Selected Method.
-			if (selectedMethod == 6)
-				exit(0);
-			else if (selectedMethod != 5){
-				try{
-					Solution solution;
-					switch (selectedMethod){
-					case BISECTION:
-						cout << "Solving using Bisection method: " << endl;
-						solution = findRootByBisection(formulae[selectedEquation]); //Compute the root using Bisection Method.
-						break;
-					case SECANT:
-						cout << "Solving using Secant Method: " << endl;
-						solution = findRootBySecant(formulae[selectedEquation]); //Compute the root using Secant Method.
-						break;
-					case FALSEP:
-						cout << "Solving using False-Position Method: " << endl;
-						solution = findRootByFalsePosition(formulae[selectedEquation]); //Compute the root using False-Position Method.
-						break;
-					case NEWTON:
-						cout << "Solving using Newton-Raphson Method: " << endl;
-						solution = findRootByNewton(formulae[selectedEquation], dformulae[selectedEquation]); //Compute the root using Newton-Raphson Method.
-					}
-					system("cls");
-					cout << "Solution of the selected equation using the selected method is: " << endl //Print the result.
-						<< "x = " << solution.root << endl
-						<< "Error: ~" << solution.error * 100.0 << " %" << endl
-						<< "Number of iterations: " << solution.iterations << endl;
-
-				} catch (divideByZeroException &e){
-					cout << e.what() << endl;
-				} catch (incompatibleMethodException &e){
-					cout << e.what() << endl;
-				} catch (logZeroException &e){
-					cout << e.what() << endl;
-				}
+constexpr Dual operator+(const Dual &u, const Dual &v) { //Adding two Dual Numbers Operator.
+	return Dual(u.value + v.value, u.first + v.first, u.second + v.second);
+}
 
-				system("pause");
-				system("cls");
+constexpr Dual operator-(const Dual &u, const Dual &v) { //Subtracting two Dual Numbers Operator.
+	return Dual(u.value - v.value, u.first - v.first, u.second - v.second);
+}
 
-				displayExitMenu(); //Next Action Menu.
-				int exitOption = getSelection(1, 3); //Get Selected Action.
-				if (exitOption == 3)
-					exit(0);
-				else if (exitOption == 2)
-					break;
-			} else
-				break;
-		}
-	}
-	return 0;
+constexpr Dual operator-(const Dual &u) { //Negating Dual Number Operator.
+	return Dual(-u.value, -u.first, -u.second);
 }
 
-void initFormulae() {
-	formulae[1] = [](double x) {
-		return (pow(x, 3) - 8 * pow(x, 2) + 12 * x - 4); //First Equation.
-	};
+constexpr Dual operator*(const Dual &u, const Dual &v) { //Multiplying two Dual Numbers Operator.
+	return Dual(u.value * v.value, u.first * v.value + u.value * v.first,
+		u.second * v.value + 2 * u.first * v.first + u.value * v.second);
+}
 
-	formulae[2] = [](double x) {
-		return (-12 - 21 * x + 18 * pow(x, 2) - 2.75 * pow(x, 3)); //Second Equation.
-	};
+constexpr Dual quotient(const Dual &u, const Dual &v, double value, double first) { //Completing a Dual division from the quotient's value and first derivative.
+	return Dual(value, first, (u.second - 2 * first * v.first - value * v.second) / v.value);
+}
 
-	formulae[3] = [](double x) {
-		return (6 * x - 4 * pow(x, 2) + 0.5 * pow(x, 3) - 2); //Third Equation.
-	};
+constexpr Dual operator/(const Dual &u, const Dual &v) { //Dividing two Dual Numbers Operator.
+	return quotient(u, v, u.value / v.value, (u.first - (u.value / v.value) * v.first) / v.value);
+}
 
-	formulae[4] = [](double x) {
-		if (pow(x, 4) == 0)
-			throw logZeroException();
-		return log(pow(x, 4)) - 0.7; //Fourth Equation.
-	};
+constexpr bool operator==(const Dual &u, const Dual &v) { //Comparing the values of two Dual Numbers Operator.
+	return u.value == v.value;
+}
 
-	formulae[5] = [](double x) {
-		return (7 * sin(x) - exp(x)); //Fifth Equation.
-	};
+Dual chain(const Dual &u, double f, double df, double ddf) { //Applying a scalar function with value f, derivative df and second derivative ddf at u.value.
+	return Dual(f, df * u.first, ddf * u.first * u.first + df * u.second);
+}
 
-	dformulae[1] = [](double x) {
-		return (3 * pow(x, 3) - 16 * x + 12); //First Equation Derivative.
-	};
+Dual pow(const Dual &u, double n) {
+	return chain(u, pow(u.value, n), n * pow(u.value, n - 1), n * (n - 1) * pow(u.value, n - 2));
+}
 
-	dformulae[2] = [](double x) {
-		return (-21 + 36 * x - 8.25 * pow(x, 2)); //Second Equation Derivative.
-	};
+Dual sin(const Dual &u) {
+	return chain(u, sin(u.value), cos(u.value), -sin(u.value));
+}
 
-	dformulae[3] = [](double x) {
-		return (6 - 8 * x + 1.5 * pow(x, 2));  //Third Equation Derivative.
-	};
+Dual cos(const Dual &u) {
+	return chain(u, cos(u.value), -sin(u.value), -cos(u.value));
+}
 
-	dformulae[4] = [](double x) {
-		if (x == 0)
-			throw divideByZeroException();
-		return (3 / x);  //Fourth Equation Derivative.
-	};
+Dual exp(const Dual &u) {
+	double e = exp(u.value);
+	return chain(u, e, e, e);
+}
 
-	dformulae[5] = [](double x) {
-		return (7 * cos(x) - exp(x));  //Fifth Equation Derivative.
-	};
+Dual log(const Dual &u) {
+	return chain(u, log(u.value), 1 / u.value, -1 / (u.value * u.value));
 }
 
-void displayEquationsMenu() { //Printing Equation Selection Menu.
-	cout << "Select the equation you want to solve:" << endl
-		<< "1) x^3 - 8x^2 + 12x = 4" << endl
-		<< "2) f(x) = -12 - 21x + 18x^2 - 2.75x^3" << endl
-		<< "3) f(x) = 6x - 4x^2 + 0.5 x^3 - 2" << endl
-		<< "4) ln(x^4) =  0.7" << endl
-		<< "5) 7sin(x) = e^x" << endl
-		<< "6) Quit." << endl;
+Dual tan(const Dual &u) {
+	double t = tan(u.value), secant2 = 1 + t * t;
+	return chain(u, t, secant2, 2 * t * secant2);
 }
 
-void displayMethodsMenu() { //Printing Method Selection Menu.
-	cout << "Select the method you want to solve with:" << endl
-		<< "1) Bisection Method." << endl
-		<< "2) Secant Method." << endl
-		<< "3) False-Position Method." << endl
-		<< "4) Newton-Raphson Method." << endl
-		<< "5) Previous Menu." << endl
-		<< "6) Quit." << endl;
+Dual sqrt(const Dual &u) {
+	double root = sqrt(u.value);
+	return chain(u, root, 0.5 / root, -0.25 / (root * u.value));
 }
 
-void displayExitMenu() { //Printing Exit Menu.
-	cout << "Select one of the following actions:" << endl
-		<< "1) Solve with another method." << endl
-		<< "2) Solve another equation." << endl
-		<< "3) Quit." << endl;
+Dual pow(const Dual &u, const Dual &v) { //u^v = e^(v ln u).
+	return exp(v * log(u));
 }
 
-int getSelection(int min, int max) { //Geting User Selected Option.
-	char selection = ' ';
-	bool selected = false;
 
-	while (!selected){
-		cout << "Input: ";
-		cin >> selection;
-		if (selection >= (min + 48) && selection <= (max + 48))
-			selected = true;
-		else
-			cout << "Invalid option. " << endl << selection << endl;
+//----Interval Struct----------
+struct Interval { //Closed interval [lower, upper]; the arithmetic below rounds outward, so results enclose every value over the range.
+	double lower;
+	double upper;
+	Interval(double value = 0) :lower(value), upper(value) {}
+	Interval(double lower, double upper) :lower(lower), upper(upper) {}
+
+	static Interval emptySet() { //Result over a range entirely outside a function's domain; it holds no value, not even 0.
+		return Interval(numeric_limits<double>::infinity(), -numeric_limits<double>::infinity());
 	}
 
-	char buf[2];
-	buf[0] = selection;
-	buf[1] = 0;
+	bool empty() const {
+		return upper < lower;
+	}
 
-	return atoi(buf);
+	double width() const {
+		return upper - lower;
+	}
+
+	double middle() const {
+		return lower + 0.5 * (upper - lower);
+	}
+
+	bool contains(double x) const {
+		return lower <= x && x <= upper;
+	}
+};
+
+Interval enclose(double lower, double upper, int ulps) { //Widening computed bounds by ulps units in the last place; NaN bounds give the whole real line.
+	const double infinity = numeric_limits<double>::infinity();
+	if (lower != lower || upper != upper)
+		return Interval(-infinity, infinity);
+	for (int i = 0; i < ulps; i++){
+		lower = nextafter(lower, -infinity);
+		upper = nextafter(upper, infinity);
+	}
+	return Interval(lower, upper);
 }
 
-bool rootExists(Formula fx, double xl, double xh) { //Checking the Existence of root in interval for Closed Methods.
-	return (fx(xl) * fx(xh) <= 0);
+bool containsPhase(const Interval &x, double phase, double period) { //Checking whether phase + k * period lies in x for some integer k (conservatively).
+	double slack = 1e-12 * (1 + max(fabs(x.lower), fabs(x.upper)));
+	double k = ceil((x.lower - slack - phase) / period);
+	return phase + k * period <= x.upper + slack;
 }
 
-Solution findRootByBisection(Formula fx) { //Computing the root using Bisection Method. 
-	double xl, xh, oldRoot = 0, newRoot = 1, error = DBL_MAX;
-	Solution solution;
-	solution.error = 0;
-	solution.iterations = 0;
+Interval operator+(const Interval &u, const Interval &v) { //Adding two Intervals Operator.
+	if (u.empty() || v.empty())
+		return Interval::emptySet();
+	return enclose(u.lower + v.lower, u.upper + v.upper, 1);
+}
 
-	do{ //Getting initial guesses.
-		cout << "Enter the lower bound guess: ";
-		cin >> xl;
-		cout << "Enter the higher bound guess: ";
-		cin >> xh;
-		if (!rootExists(fx, xl, xh))
-			cout << "No root is found between the specified boundaries or the boundaries enclose two roots." << endl;
-		else
-			oldRoot = (xl + xh) / 2.0;
-	} while(!rootExists(fx, xl, xh)); //Validating Existence of root between the guesses.
+Interval operator-(const Interval &u, const Interval &v) { //Subtracting two Intervals Operator.
+	if (u.empty() || v.empty())
+		return Interval::emptySet();
+	return enclose(u.lower - v.upper, u.upper - v.lower, 1);
+}
 
-	int iterations = 0; //Number of iterations.
-	while (error > EPSILON){ //Iterations loop.
-		if (iterations > MAX_ITERATIONS)
-			throw incompatibleMethodException();
-		if (rootExists(fx, xl, oldRoot)){
-			newRoot = (xl + oldRoot) / 2.0;
-		} else if (rootExists(fx, oldRoot, xh) ){ //Checking the new sub-interval.
-			newRoot = (oldRoot + xh) / 2.0;
-		} else{
-			cout << "Unexpected error." << endl;
-			exit(1);
-		}
+Interval operator-(const Interval &u) { //Negating Interval Operator.
+	if (u.empty())
+		return u;
+	return Interval(-u.upper, -u.lower);
+}
 
-		if (rootExists(fx, xl, newRoot))
-			xh = newRoot;
-		else if (rootExists(fx, newRoot, xh))
-			xl = newRoot;
-		else{
-			cout << "Unexpected error." << endl;
-			exit(1);
-		}
+Interval operator*(const Interval &u, const Interval &v) { //Multiplying two Intervals Operator.
+	if (u.empty() || v.empty())
+		return Interval::emptySet();
+	double a = u.lower * v.lower, b = u.lower * v.upper, c = u.upper * v.lower, d = u.upper * v.upper;
+	return enclose(min(min(a, b), min(c, d)), max(max(a, b), max(c, d)), 1);
+}
 
-		error = ((oldRoot - newRoot) / newRoot); //Error computation.
+Interval operator/(const Interval &u, const Interval &v) { //Dividing two Intervals Operator (the whole real line when v holds 0).
+	if (u.empty() || v.empty())
+		return Interval::emptySet();
+	if (v.contains(0))
+		return enclose(numeric_limits<double>::quiet_NaN(), 0, 0);
+	double a = u.lower / v.lower, b = u.lower / v.upper, c = u.upper / v.lower, d = u.upper / v.upper;
+	return enclose(min(min(a, b), min(c, d)), max(max(a, b), max(c, d)), 1);
+}
 
-		if (error < 0)
-			error *= -1;
+Interval exp(const Interval &x) {
+	if (x.empty())
+		return x;
+	Interval result = enclose(exp(x.lower), exp(x.upper), 2);
+	result.lower = max(result.lower, 0.0);
+	return result;
+}
 
-		oldRoot = newRoot;
-		iterations++;
-	}
-	solution.root = newRoot;
-	if (fx(newRoot) != 0)
-		solution.error = error;
-	else
-		solution.error = 0;
-	solution.iterations = iterations;
-	return solution;
+Interval log(const Interval &x) { //ln over the positive part of x; empty when x has none.
+	if (x.empty() || x.upper <= 0)
+		return Interval::emptySet();
+	return enclose((x.lower <= 0) ? -numeric_limits<double>::infinity() : log(x.lower), log(x.upper), 2);
 }
 
-Solution findRootBySecant(Formula fx) { //Computing the root using Secant Method.
-	double oldRoot0, oldRoot1, newRoot = 1, error = DBL_MAX;
-	Solution solution;
-	solution.error = 0;
-	solution.iterations = 0;
+Interval sqrt(const Interval &x) { //Square root over the non-negative part of x; empty when x has none.
+	if (x.empty() || x.upper < 0)
+		return Interval::emptySet();
+	Interval result = enclose((x.lower <= 0) ? 0 : sqrt(x.lower), sqrt(x.upper), 2);
+	result.lower = max(result.lower, 0.0);
+	return result;
+}
 
-	auto nextRoot = [](Formula fxn, double x0, double x1) { //Next root computation function.
-		double numerator = (x1 - x0);
-		double denumerator = fxn(x1) - fxn(x0);
-		
-		if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
-			return x1;
-		else if (denumerator == 0)
-			throw divideByZeroException();
+Interval pow(const Interval &x, double n) {
+	if (x.empty())
+		return x;
+	if (n != floor(n) || fabs(n) > 1e9) //Real exponent: e^(n ln x).
+		return exp(Interval(n) * log(x));
+	if (n == 0)
+		return Interval(1);
+	if (n < 0)
+		return Interval(1) / pow(x, -n);
+	double a = pow(x.lower, n), b = pow(x.upper, n);
+	if (fmod(n, 2) != 0) //Odd powers are increasing.
+		return enclose(a, b, 2);
+	Interval result = x.contains(0) ? enclose(0, max(a, b), 2) : enclose(min(a, b), max(a, b), 2);
+	result.lower = max(result.lower, 0.0);
+	return result;
+}
 
-		return x1 - (fxn(x1) * (numerator / denumerator));
-	};
+Interval pow(const Interval &u, const Interval &v) { //u^v = e^(v ln u).
+	return exp(v * log(u));
+}
 
+Interval sin(const Interval &x) {
+	const double pi = 4 * atan(1.0);
+	if (x.empty())
+		return x;
+	if (x.width() >= 2 * pi || x.width() != x.width())
+		return Interval(-1, 1);
+	Interval result = enclose(min(sin(x.lower), sin(x.upper)), max(sin(x.lower), sin(x.upper)), 2);
+	if (containsPhase(x, pi / 2, 2 * pi)) //Maximum inside the interval.
+		result.upper = 1;
+	if (containsPhase(x, -pi / 2, 2 * pi)) //Minimum inside the interval.
+		result.lower = -1;
+	return Interval(max(result.lower, -1.0), min(result.upper, 1.0));
+}
 
-	
-	//Getting Initial Guesses.
-	cout << "Enter the lower bound guess: ";
-	cin >> oldRoot0;
-	cout << "Enter the higher bound guess: ";
-	cin >> oldRoot1;
-	
-	oldRoot1 = nextRoot(fx, oldRoot0, oldRoot1); //Initial computation.
-	int iterations = 0;
-	while (error > EPSILON){ //Iterations loop.
-		if (iterations > MAX_ITERATIONS)
-			throw incompatibleMethodException();
-		newRoot = nextRoot(fx, oldRoot0, oldRoot1); //Computing next root.
+Interval cos(const Interval &x) {
+	const double pi = 4 * atan(1.0);
+	if (x.empty())
+		return x;
+	if (x.width() >= 2 * pi || x.width() != x.width())
+		return Interval(-1, 1);
+	Interval result = enclose(min(cos(x.lower), cos(x.upper)), max(cos(x.lower), cos(x.upper)), 2);
+	if (containsPhase(x, 0, 2 * pi)) //Maximum inside the interval.
+		result.upper = 1;
+	if (containsPhase(x, pi, 2 * pi)) //Minimum inside the interval.
+		result.lower = -1;
+	return Interval(max(result.lower, -1.0), min(result.upper, 1.0));
+}
 
-		error = ((oldRoot1 - newRoot) / newRoot); //Error computation.
-		if (error < 0)
-			error *= -1;
+Interval tan(const Interval &x) { //The whole real line when x holds a pole.
+	const double pi = 4 * atan(1.0);
+	if (x.empty())
+		return x;
+	if (x.width() >= pi || x.width() != x.width() || containsPhase(x, pi / 2, pi))
+		return enclose(numeric_limits<double>::quiet_NaN(), 0, 0);
+	return enclose(tan(x.lower), tan(x.upper), 2);
+}
 
-		oldRoot0 = oldRoot1;
-		oldRoot1 = newRoot;
-		iterations++;
-	}
-	solution.root = newRoot;
-	if (fx(newRoot) != 0)
-		solution.error = error;
-	else
-		solution.error = 0;
-	solution.iterations = iterations;
-	return solution;
+bool intersect(const Interval &u, const Interval &v, Interval &result) { //Intersecting two Intervals; false when they are disjoint.
+	result = Interval(max(u.lower, v.lower), min(u.upper, v.upper));
+	return result.lower <= result.upper;
 }
 
-Solution findRootByFalsePosition(Formula fx) { //Computing the root using False-Position Method.
-	double xl, xh, oldRoot, newRoot = 1, error = DBL_MAX;
-	Solution solution;
-	solution.error = 0;
-	solution.iterations = 0;
 
-	auto nextRoot = [](Formula fxn, double x0, double x1) { //Next root computation function.
-		double numerator = (x1 - x0);
-		double denumerator = fxn(x1) - fxn(x0);
+//----Interval Dual Number Struct----------
+struct IntervalDual { //First-order Dual Number over Intervals: encloses f and f' over a range of x.
+	Interval value;
+	Interval first;
+	IntervalDual(double value = 0) :value(value), first(0) {}
+	IntervalDual(const Interval &value, const Interval &first) :value(value), first(first) {}
+};
 
-		if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
-			return x1;
-		else if (denumerator == 0)
-			throw divideByZeroException();
+IntervalDual operator+(const IntervalDual &u, const IntervalDual &v) { //Adding two Interval Dual Numbers Operator.
+	return IntervalDual(u.value + v.value, u.first + v.first);
+}
 
-		return x1 - (fxn(x1) * (numerator / denumerator));
-	};
+IntervalDual operator-(const IntervalDual &u, const IntervalDual &v) { //Subtracting two Interval Dual Numbers Operator.
+	return IntervalDual(u.value - v.value, u.first - v.first);
+}
 
-	do{ //Getting inital guesses.
-		cout << "Enter the lower bound guess: ";
-		cin >> xl;
-		cout << "Enter the higher bound guess: ";
-		cin >> xh;
-		if (!rootExists(fx, xl, xh))
-			cout << "No root is found between the specified boundaries or the boundaries enclose two roots." << endl;
-		else
-			oldRoot = nextRoot(fx, xl, xh);
-	} while (!rootExists(fx, xl, xh));
+IntervalDual operator-(const IntervalDual &u) { //Negating Interval Dual Number Operator.
+	return IntervalDual(-u.value, -u.first);
+}
 
-	int iterations = 0;
-	while (error > EPSILON){ //Iterations loop.
-		if (iterations > MAX_ITERATIONS)
-			throw incompatibleMethodException();
-		if (rootExists(fx, xl, oldRoot)){ //Checking the new sub-interval.
-			newRoot = nextRoot(fx, xl, oldRoot);
-		} else if (rootExists(fx, oldRoot, xh)){
-			newRoot = nextRoot(fx, oldRoot, xh);
-		} else{
-			cout << "Unexpected error." << endl;
-			exit(1);
-		}
+IntervalDual operator*(const IntervalDual &u, const IntervalDual &v) { //Multiplying two Interval Dual Numbers Operator.
+	return IntervalDual(u.value * v.value, u.first * v.value + u.value * v.first);
+}
 
-		if (rootExists(fx, xl, newRoot))
-			xh = newRoot;
-		else if (rootExists(fx, newRoot, xh))
-			xl = newRoot;
-		else{
-			cout << "Unexpected error." << endl;
-			exit(1);
-		}
+IntervalDual operator/(const IntervalDual &u, const IntervalDual &v) { //Dividing two Interval Dual Numbers Operator.
+	Interval value = u.value / v.value;
+	return IntervalDual(value, (u.first - value * v.first) / v.value);
+}
 
-		error = ((oldRoot - newRoot) / newRoot); //Error computation.
+IntervalDual chain(const IntervalDual &u, const Interval &f, const Interval &df) { //Applying a scalar function with enclosures f and df over u.value.
+	return IntervalDual(f, df * u.first);
+}
 
-		if (error < 0)
-			error *= -1;
+IntervalDual pow(const IntervalDual &u, double n) {
+	return chain(u, pow(u.value, n), Interval(n) * pow(u.value, n - 1));
+}
 
-		oldRoot = newRoot;
-		iterations++;
-	}
-	solution.root = newRoot;
-	if(fx(newRoot) != 0)
-		solution.error = error;
-	else
-		solution.error = 0;
-	solution.iterations = iterations;
-	return solution;
+IntervalDual sin(const IntervalDual &u) {
+	return chain(u, sin(u.value), cos(u.value));
 }
 
-Solution findRootByNewton(Formula fx, Formula dfx) {//Computing the root using Newton-Raphson Method.
-	double x0, newRoot = 1, error = DBL_MAX;
-	Solution solution;
-	solution.error = 0;
-	solution.iterations = 0;
+IntervalDual cos(const IntervalDual &u) {
+	return chain(u, cos(u.value), -sin(u.value));
+}
 
-	auto nextRoot = [](Formula fxn, Formula dfxn, double x0) { //Next root computation function.
-		double numerator = fxn(x0);
-		double denumerator = dfxn(x0);
+IntervalDual exp(const IntervalDual &u) {
+	Interval e = exp(u.value);
+	return chain(u, e, e);
+}
 
-		if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
-			return x0;
-		else if (denumerator == 0)
-			throw divideByZeroException();
+IntervalDual log(const IntervalDual &u) {
+	return chain(u, log(u.value), Interval(1) / u.value);
+}
 
-		return x0 - (numerator / denumerator);
-	};
+IntervalDual tan(const IntervalDual &u) { //Across a pole f is not continuous, so f' gets the whole real line as well and the box is never taken as monotonic.
+	Interval t = tan(u.value);
+	if (!isfinite(t.lower) || !isfinite(t.upper))
+		return IntervalDual(t, enclose(numeric_limits<double>::quiet_NaN(), 0, 0));
+	return chain(u, t, Interval(1) + pow(t, 2.0));
+}
 
-	//Getting the initial guess.
-	cout << "Enter the initial guess: ";
-	cin >> x0;
-	x0 = nextRoot(fx, dfx, x0);
-	
+IntervalDual sqrt(const IntervalDual &u) {
+	Interval root = sqrt(u.value);
+	return chain(u, root, Interval(0.5) / root);
+}
 
-	int iterations = 0;
-	while (error > EPSILON){ //Itertaions loop.
-		if (iterations > MAX_ITERATIONS)
-			throw incompatibleMethodException();
-		newRoot = nextRoot(fx, dfx, x0); //Computing next root.
+IntervalDual pow(const IntervalDual &u, const IntervalDual &v) { //u^v = e^(v ln u).
+	return exp(v * log(u));
+}
 
-		error = ((newRoot - x0) / newRoot); //Error computation.
 
-		if (error < 0)
-			error *= -1;
+//----Equations' Function Objects (T: double or Dual)----------
+template <typename T>
+constexpr T horner(const double *coefficients, int degree, T x) { //Evaluating coefficients[0] + coefficients[1] x + ... + coefficients[degree] x^degree by Horner's rule.
+	return (degree == 0) ? T(coefficients[0]) : horner(coefficients + 1, degree - 1, x) * x + coefficients[0];
+}
 
-		x0 = newRoot;
-		iterations++;
+struct Equation1 { //First Equation (x^3 - 8x^2 + 12x - 4).
+	template <typename T> constexpr T operator()(T x) const {
+		return horner(POLYNOMIAL_COEFFICIENTS[1], POLYNOMIAL_DEGREE, x);
 	}
-	solution.root = newRoot;
-	if (fx(newRoot) != 0)
-		solution.error = error;
-	else
-		solution.error = 0;
-	solution.iterations = iterations;
-	return solution;
-}
\ No newline at end of file
+};
+
+struct Equation2 { //Second Equation (-12 - 21x + 18x^2 - 2.75x^3).
+	template <typename T> constexpr T operator()(T x) const {
+		return horner(POLYNOMIAL_COEFFICIENTS[2], POLYNOMIAL_DEGREE, x);
+	}
+};
+
+struct Equation3 { //Third Equation (6x - 4x^2 + 0.5x^3 - 2).
+	template <typename T> constexpr T operator()(T x) const {
+		return horner(POLYNOMIAL_COEFFICIENTS[3], POLYNOMIAL_DEGREE, x);
+	}
+};
+
+struct Equation4 { //Fourth Equation (-inf at x = 0, reported by the solvers as a domain error).
+	template <typename T> T operator()(T x) const {
+		return log(pow(x, 4)) - 0.7;
+	}
+};
+
+struct Equation5 { //Fifth Equation.
+	template <typename T> T operator()(T x) const {
+		return (7 * sin(x) - exp(x));
+	}
+};
+
+template <typename F>
+struct Derivative { //Equation Derivative, computed by automatic differentiation.
+	F fx;
+	constexpr double operator()(double x) const {
+		return fx(Dual(x, 1)).first;
+	}
+};
+
+
+//----Polynomial Class----------
+class Polynomial { //Polynomial equation, coefficients stored from the constant term up.
+	vector<double> coefficients;
+
+public:
+	Polynomial() {}
+
+	Polynomial(const double *terms, int count) :coefficients(terms, terms + count) { //Constructor.
+		while (coefficients.size() > 1 && coefficients.back() == 0) //Trimming zero leading coefficients.
+			coefficients.pop_back();
+	}
+
+	int degree() const {
+		return coefficients.empty() ? 0 : (int)coefficients.size() - 1;
+	}
+
+	template <typename T> T operator()(T x) const { //Evaluating using Horner's rule (T: double, Dual or complex).
+		if (coefficients.empty())
+			return T(0);
+		T result = T(coefficients.back());
+		for (int i = degree() - 1; i >= 0; i--)
+			result = result * x + coefficients[i];
+		return result;
+	}
+
+	template <typename T> T evaluate(T x, T &derivative) const { //Evaluating the polynomial and its derivative in one Horner pass.
+		T result = T(coefficients.empty() ? 0 : coefficients.back());
+		derivative = T(0);
+		for (int i = degree() - 1; i >= 0; i--){
+			derivative = derivative * x + result;
+			result = result * x + coefficients[i];
+		}
+		return result;
+	}
+
+	vector<complex<double> > roots(SolutionStatus &status) const { //Computing all the real and complex roots using Aberth-Ehrlich iteration.
+		int n = degree();
+		vector<complex<double> > z(n);
+		status = SOLVED;
+		if (n < 1)
+			return z;
+
+		double radius = 0; //Cauchy bound on the roots' magnitude.
+		for (int i = 0; i < n; i++)
+			radius = max(radius, fabs(coefficients[i] / coefficients[n]));
+		radius += 1;
+		for (int k = 0; k < n; k++) //Initial guesses spread on a circle, off the real axis.
+			z[k] = polar(radius, (2 * 4 * atan(1.0) * k) / n + 0.4);
+
+		int iterations = 0;
+		double error = DBL_MAX;
+		while (error > EPSILON * EPSILON){ //Iterations loop.
+			if (iterations > MAX_ITERATIONS){ //The current approximations are returned with the failure.
+				status = NOT_CONVERGED;
+				break;
+			}
+			error = 0;
+			for (int k = 0; k < n; k++){
+				complex<double> derivative, value = evaluate(z[k], derivative);
+				if (value == 0.0)
+					continue;
+				complex<double> ratio = value / derivative, repulsion = 0;
+				for (int j = 0; j < n; j++) //Pushing the approximations away from each other.
+					if (j != k)
+						repulsion += 1.0 / (z[k] - z[j]);
+				complex<double> step = ratio / (1.0 - ratio * repulsion);
+				z[k] -= step;
+				error = max(error, abs(step) / max(abs(z[k]), 1.0));
+			}
+			iterations++;
+		}
+		return z;
+	}
+};
+
+//----Expression Class----------
+class Expression { //Equation compiled from text (e.g. "x^3 - 8x^2 + 12x = 4") into register bytecode; 'p' is an optional family parameter.
+public:
+	enum Operation { LOAD_X, LOAD_PARAMETER, LOAD_CONSTANT, COPY, ADD, SUBTRACT, MULTIPLY, DIVIDE, NEGATE, POWER, SIN, COS, TAN, EXP, LOG, SQRT };
+
+	Expression() { //Default expression: f(x) = 0.
+		Instruction zero = { LOAD_CONSTANT, 0, 0, 0, 0 };
+		code.push_back(zero);
+	}
+
+	explicit Expression(const string &text) { //Parsing, folding and compiling the text.
+		Parser parser(text, nodes);
+		int root = parser.parse();
+		root = fold(root);
+		emit(root, 0);
+		nodes.clear();
+	}
+
+	template <typename T> T operator()(T x, double p = 0) const { //Running the bytecode; the result is left in register 0.
+		T r[EXPRESSION_REGISTERS];
+		for (size_t i = 0; i < code.size(); i++){
+			const Instruction &in = code[i];
+			switch (in.op){
+			case LOAD_X: r[in.target] = x; break;
+			case LOAD_PARAMETER: r[in.target] = T(p); break;
+			case LOAD_CONSTANT: r[in.target] = T(in.constant); break;
+			case COPY: r[in.target] = r[in.left]; break;
+			default: r[in.target] = apply(in.op, r[in.left], r[in.right]); break;
+			}
+		}
+		return r[0];
+	}
+
+	template <typename T> static T apply(int op, const T &a, const T &b) { //Applying a unary (on a) or binary operation.
+		switch (op){
+		case ADD: return a + b;
+		case SUBTRACT: return a - b;
+		case MULTIPLY: return a * b;
+		case DIVIDE: return a / b;
+		case NEGATE: return -a;
+		case POWER: return pow(a, b);
+		case SIN: return sin(a);
+		case COS: return cos(a);
+		case TAN: return tan(a);
+		case EXP: return exp(a);
+		case LOG: return log(a);
+		case SQRT: return sqrt(a);
+		default: throw invalidExpressionException();
+		}
+	}
+
+private:
+	struct Instruction { //Register instruction: target = left op right.
+		unsigned char op, target, left, right;
+		double constant;
+	};
+
+	struct Node { //Syntax tree node; children are indices into nodes.
+		int op;
+		double constant;
+		int left, right;
+	};
+
+	class Parser { //Recursive descent parser producing syntax tree nodes.
+		const string &text;
+		vector<Node> &nodes;
+		size_t position;
+
+	public:
+		Parser(const string &text, vector<Node> &nodes) :text(text), nodes(nodes), position(0) {}
+
+		int parse() { //equation := expression ['=' expression]
+			int left = parseExpression();
+			if (peek() == '='){
+				position++;
+				left = add(SUBTRACT, left, parseExpression());
+			}
+			if (peek() != 0)
+				throw invalidExpressionException();
+			return left;
+		}
+
+	private:
+		char peek() { //Next non-blank character, or 0 at the end.
+			while (position < text.size() && isspace((unsigned char)text[position]))
+				position++;
+			return (position < text.size()) ? text[position] : 0;
+		}
+
+		int add(int op, int left = -1, int right = -1, double constant = 0) {
+			Node node = { op, constant, left, right };
+			nodes.push_back(node);
+			return (int)nodes.size() - 1;
+		}
+
+		int parseExpression() { //expression := term (('+' | '-') term)*
+			int left = parseTerm();
+			while (peek() == '+' || peek() == '-'){
+				int op = (text[position++] == '+') ? ADD : SUBTRACT;
+				left = add(op, left, parseTerm());
+			}
+			return left;
+		}
+
+		int parseTerm() { //term := unary (('*' | '/' | implicit multiplication) unary)*
+			int left = parseUnary();
+			while (1){
+				char c = peek();
+				if (c == '*' || c == '/'){
+					position++;
+					left = add((c == '*') ? MULTIPLY : DIVIDE, left, parseUnary());
+				} else if (isalnum((unsigned char)c) || c == '.' || c == '('){ //"12x", "7sin(x)", "2(x + 1)".
+					left = add(MULTIPLY, left, parseUnary());
+				} else
+					return left;
+			}
+		}
+
+		int parseUnary() { //unary := ('-' | '+') unary | power
+			char c = peek();
+			if (c == '-' || c == '+'){
+				position++;
+				int operand = parseUnary();
+				return (c == '-') ? add(NEGATE, operand) : operand;
+			}
+			return parsePower();
+		}
+
+		int parsePower() { //power := primary ['^' unary]
+			int base = parsePrimary();
+			if (peek() == '^'){
+				position++;
+				return add(POWER, base, parseUnary());
+			}
+			return base;
+		}
+
+		int parsePrimary() { //primary := number | 'x' | 'p' | 'e' | 'pi' | function '(' arguments ')' | '(' expression ')'
+			char c = peek();
+			if (c == '('){
+				position++;
+				int inner = parseExpression();
+				expect(')');
+				return inner;
+			}
+			if (isdigit((unsigned char)c) || c == '.'){
+				const char *start = text.c_str() + position;
+				char *end;
+				double value = strtod(start, &end);
+				if (end == start)
+					throw invalidExpressionException();
+				position += end - start;
+				return add(LOAD_CONSTANT, -1, -1, value);
+			}
+			if (!isalpha((unsigned char)c))
+				throw invalidExpressionException();
+
+			size_t start = position;
+			while (position < text.size() && isalpha((unsigned char)text[position]))
+				position++;
+			string name = text.substr(start, position - start);
+			if (name == "x")
+				return add(LOAD_X);
+			if (name == "p")
+				return add(LOAD_PARAMETER);
+			if (name == "e")
+				return add(LOAD_CONSTANT, -1, -1, exp(1.0));
+			if (name == "pi")
+				return add(LOAD_CONSTANT, -1, -1, 4 * atan(1.0));
+
+			int op;
+			if (name == "sin") op = SIN;
+			else if (name == "cos") op = COS;
+			else if (name == "tan") op = TAN;
+			else if (name == "exp") op = EXP;
+			else if (name == "ln" || name == "log") op = LOG;
+			else if (name == "sqrt") op = SQRT;
+			else if (name == "pow") op = POWER;
+			else throw invalidExpressionException();
+
+			expect('(');
+			int argument = parseExpression();
+			if (op == POWER){ //pow(base, exponent).
+				expect(',');
+				argument = add(POWER, argument, parseExpression());
+			} else
+				argument = add(op, argument);
+			expect(')');
+			return argument;
+		}
+
+		void expect(char c) {
+			if (peek() != c)
+				throw invalidExpressionException();
+			position++;
+		}
+	};
+
+	vector<Instruction> code;
+	vector<Node> nodes; //Only used while compiling.
+
+	bool isConstant(int index) const {
+		return nodes[index].op == LOAD_CONSTANT;
+	}
+
+	int fold(int index) { //Constant folding and strength reduction of the syntax tree.
+		Node &node = nodes[index];
+		if (node.left >= 0)
+			node.left = fold(node.left);
+		if (node.right >= 0)
+			node.right = fold(node.right);
+		Node folded = nodes[index];
+
+		bool unary = folded.op >= NEGATE && folded.op != POWER;
+		if (folded.left >= 0 && isConstant(folded.left) && (unary || isConstant(folded.right))){ //Every operand is known.
+			double right = unary ? 0 : nodes[folded.right].constant;
+			folded.constant = apply(folded.op, nodes[folded.left].constant, right);
+			folded.op = LOAD_CONSTANT;
+			folded.left = folded.right = -1;
+		} else if (folded.op == POWER && isConstant(folded.left) && nodes[folded.left].constant == exp(1.0)){ //e^u = exp(u).
+			folded.op = EXP;
+			folded.left = folded.right;
+			folded.right = -1;
+		}
+		nodes[index] = folded;
+		return index;
+	}
+
+	void push(int op, int target, int left = 0, int right = 0, double constant = 0) {
+		if (target >= EXPRESSION_REGISTERS)
+			throw invalidExpressionException();
+		Instruction in = { (unsigned char)op, (unsigned char)target, (unsigned char)left, (unsigned char)right, constant };
+		code.push_back(in);
+	}
+
+	void emit(int index, int target) { //Emitting the code that leaves the node value in register target (higher registers are scratch).
+		const Node &node = nodes[index];
+		switch (node.op){
+		case LOAD_X:
+		case LOAD_PARAMETER:
+			push(node.op, target);
+			return;
+		case LOAD_CONSTANT:
+			push(LOAD_CONSTANT, target, 0, 0, node.constant);
+			return;
+		case POWER:
+			if (isConstant(node.right)){
+				double n = nodes[node.right].constant;
+				if (n == floor(n) && fabs(n) <= 64){ //Lowering u^n to multiplications by repeated squaring.
+					emitIntegerPower(node.left, (int)n, target);
+					return;
+				}
+			}
+			break;
+		}
+
+		bool unary = node.op >= NEGATE && node.op != POWER;
+		emit(node.left, target);
+		if (!unary)
+			emit(node.right, target + 1);
+		push(node.op, target, target, unary ? target : target + 1);
+	}
+
+	void emitIntegerPower(int base, int n, int target) {
+		if (n == 0){
+			push(LOAD_CONSTANT, target, 0, 0, 1);
+			return;
+		}
+		int exponent = (n < 0) ? -n : n;
+		int square = target + 1, result = target + 2;
+		emit(base, square);
+		bool first = true;
+		while (exponent > 0){
+			if (exponent & 1){
+				if (first)
+					push(COPY, result, square);
+				else
+					push(MULTIPLY, result, result, square);
+				first = false;
+			}
+			exponent >>= 1;
+			if (exponent > 0)
+				push(MULTIPLY, square, square, square);
+		}
+		if (n < 0){
+			push(LOAD_CONSTANT, target, 0, 0, 1);
+			push(DIVIDE, target, target, result);
+		} else
+			push(COPY, target, result);
+	}
+};
+
+
+//----Parameter Binding Struct----------
+template <typename G>
+struct ParameterBinding { //Equation family g(x, p) with p fixed, usable as an equation.
+	const G *family;
+	double parameter;
+	template <typename T> T operator()(T x) const {
+		return (*family)(x, parameter);
+	}
+};
+
+
+//----Helper Functions----------
+void initFormulae();
+void defineEquation(int id, const string &text);
+void definePolynomial(int id, const string &coefficients);
+void displayEquationsMenu();
+void displayMethodsMenu();
+void displayExitMenu();
+int getSelection(int min, int max);
+Solution failSolution(Solution solution, SolutionStatus status) noexcept;
+Solution invalidProblemSolution() noexcept;
+double stepError(const Tolerance &tolerance, double oldRoot, double newRoot) noexcept;
+bool hasConverged(const Tolerance &tolerance, double oldRoot, double newRoot, double residual) noexcept;
+bool withinBudget(const Tolerance &tolerance, int iterations, int evaluations) noexcept;
+
+
+//----Root Computation Functions----------
+template <typename F> bool rootExists(const F &fx, double xl, double xh);
+Solution findRootByBisection(const Formula &fx);
+Solution findRootBySecant(const Formula &fx);
+Solution findRootByFalsePosition(const Formula &fx);
+Solution findRootByNewton(const Formula &fx, const Formula &dfx);
+Solution findRootByBrent(const Formula &fx);
+Solution findRootByHalley(int equation);
+Solution findRootByBisection(const Formula &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+Solution findRootBySecant(const Formula &fx, double x0, double x1, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+Solution findRootByFalsePosition(const Formula &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+Solution findRootByNewton(const Formula &fx, const Formula &dfx, double x0, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+Solution findRootByBrent(const Formula &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+
+
+//----Inlined Root Computation Functions (F, DF: any non-throwing double(double) function object)----------
+template <typename F> Solution findRootByBisection(const F &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> Solution findRootBySecant(const F &fx, double x0, double x1, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> Solution findRootByFalsePosition(const F &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F, typename DF> Solution findRootByNewton(const F &fx, const DF &dfx, double x0, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> Solution findRootByBrent(const F &fx, double xl, double xh, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+
+
+//----Automatically Differentiated Root Computation Functions (F: function object accepting double and Dual)----------
+template <typename F> Solution findRootByDualNewton(const F &fx, double x0, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> Solution findRootByHalley(const F &fx, double x0, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+
+
+//----Multi-Root Computation Functions (return the number of failed problems, whose root is NaN)----------
+template <typename F> int findRootsByBisection(const F &fx, const double *xl, const double *xh, Solution *solutions, int count, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> int findRootsByNewton(const F &fx, const double *x0, Solution *solutions, int count, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+
+
+//----Root Scanning Functions----------
+vector<Solution> findAllRoots(const Formula &fx);
+vector<Solution> findAllRoots(const Formula &fx, double from, double to, int samples);
+template <typename F> vector<Solution> findAllRoots(const F &fx, double from, double to, int samples);
+template <typename F> Solution findMinimumByGoldenSection(const F &fx, double xl, double xh) noexcept;
+
+
+//----Verified Root Isolation Functions (undecided: boxes too narrow or left over when the budget runs out)----------
+template <typename F> vector<Interval> findRootsByIntervalNewton(const F &fx, double from, double to, vector<Interval> *undecided = nullptr, const Tolerance &tolerance = DEFAULT_TOLERANCE);
+int runIsolation(ostream &output, int equation, double from, double to, const Tolerance &tolerance);
+
+
+//----Continuation Functions (G: family object accepting (double or Dual x, double p))----------
+template <typename G> int continueRoots(const G &family, int method, const double *parameters, Solution *solutions, int count, double guess, bool extrapolate, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+int runSweep(ostream &output, int equation, int method, double guess, double from, double to, int steps, const Tolerance &tolerance);
+
+
+//----Batch Functions----------
+template <typename F> Solution solveProblemWith(const F &fx, const Problem &problem, const Tolerance &tolerance) noexcept;
+Solution solveProblem(const Problem &problem, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+template <typename F> void solveProblemsWith(const F &fx, const Problem *problems, Solution *solutions, int count, const Tolerance &tolerance) noexcept;
+void solveProblemGroup(const Problem *problems, Solution *solutions, int count, const Tolerance &tolerance = DEFAULT_TOLERANCE) noexcept;
+void solveProblems(const Problem *problems, Solution *solutions, int count, int threads, const Tolerance &tolerance = DEFAULT_TOLERANCE);
+int runRoots(ostream &output, int equation);
+int runBatch(istream &input, ostream &output, int threads);
+
+
+//----Benchmark Functions----------
+vector<double> findBenchmarkRoots(int equation);
+double getBenchmarkBracket(const vector<double> &roots, double x) noexcept;
+void runBenchmark(ostream &output, int points, int repeats);
+
+
+//----Compile-Time Root Computation Functions (F, DF: constexpr function objects, e.g. Equations 1-3 and their Derivative)----------
+//Defined before main so roots of fixed equations can be computed in constant expressions; each iteration is a recursive call.
+//They mirror the runtime solvers' iterates; an equation undefined at an estimate is a compile error instead of a DOMAIN_ERROR.
+template <typename F> constexpr Solution findRootByConstexprBisection(const F &fx, double xl, double xh) noexcept;
+template <typename F, typename DF> constexpr Solution findRootByConstexprNewton(const F &fx, const DF &dfx, double x0) noexcept;
+template <typename F> constexpr Solution bisectionLoop(const F &fx, double xl, double fl, double xh, double fh, double oldRoot, double fOld, double error, int iterations, int evaluations) noexcept;
+template <typename F, typename DF> constexpr Solution newtonLoop(const F &fx, const DF &dfx, double x, double error, int iterations, int evaluations) noexcept;
+
+constexpr Solution constexprSolution(double root, double error, int iterations, int evaluations, SolutionStatus status) noexcept { //Building a Solution in a constant expression.
+	return{ root, error, iterations, evaluations, status };
+}
+
+constexpr Solution constexprFailure(SolutionStatus status, int iterations, int evaluations) noexcept { //Failed compile-time solve, as failSolution.
+	return constexprSolution(numeric_limits<double>::quiet_NaN(), DBL_MAX, iterations, evaluations, status);
+}
+
+constexpr double relativeChange(double oldRoot, double newRoot) noexcept { //Error computation.
+	return ((oldRoot - newRoot) / newRoot < 0) ? -(oldRoot - newRoot) / newRoot : (oldRoot - newRoot) / newRoot;
+}
+
+constexpr double bisectionMidpoint(double xl, double fl, double xh, double oldRoot, double fOld) noexcept { //Checking the new sub-interval.
+	return (fl * fOld <= 0) ? (xl + oldRoot) / 2.0 : (oldRoot + xh) / 2.0;
+}
+
+template <typename F>
+constexpr Solution bisectionUpdate(const F &fx, double xl, double fl, double xh, double fh, double oldRoot, double newRoot, double fNew, int iterations, int evaluations) noexcept { //Keeping the half that holds the root.
+	return (fl * fNew <= 0)
+		? bisectionLoop(fx, xl, fl, newRoot, fNew, newRoot, fNew, relativeChange(oldRoot, newRoot), iterations + 1, evaluations)
+		: bisectionLoop(fx, newRoot, fNew, xh, fh, newRoot, fNew, relativeChange(oldRoot, newRoot), iterations + 1, evaluations);
+}
+
+template <typename F>
+constexpr Solution bisectionLoop(const F &fx, double xl, double fl, double xh, double fh, double oldRoot, double fOld, double error, int iterations, int evaluations) noexcept { //Iterations loop.
+	return (error <= EPSILON) ? constexprSolution(oldRoot, (fOld != 0) ? error : 0, iterations, evaluations, SOLVED)
+		: (iterations > MAX_ITERATIONS) ? constexprFailure(NOT_CONVERGED, iterations, evaluations)
+		: bisectionUpdate(fx, xl, fl, xh, fh, oldRoot, bisectionMidpoint(xl, fl, xh, oldRoot, fOld),
+			fx(bisectionMidpoint(xl, fl, xh, oldRoot, fOld)), iterations, evaluations + 1);
+}
+
+template <typename F>
+constexpr Solution bisectionStart(const F &fx, double xl, double fl, double xh, double fh) noexcept { //Validating Existence of root between the guesses.
+	return (fl * fh > 0) ? constexprFailure(NO_ROOT, 0, 2)
+		: bisectionLoop(fx, xl, fl, xh, fh, (xl + xh) / 2.0, fx((xl + xh) / 2.0), DBL_MAX, 0, 3);
+}
+
+template <typename F>
+constexpr Solution findRootByConstexprBisection(const F &fx, double xl, double xh) noexcept { //Computing the root using Bisection Method, at compile time when the arguments are constant.
+	return bisectionStart(fx, xl, fx(xl), xh, fx(xh));
+}
+
+constexpr double newtonRoot(double x0, double numerator, double denumerator) noexcept { //Next root computation function.
+	return (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0) ? x0 : x0 - (numerator / denumerator);
+}
+
+template <typename F, typename DF>
+constexpr Solution newtonStep(const F &fx, const DF &dfx, double x0, double numerator, double denumerator, int iterations, int evaluations) noexcept { //Computing next root.
+	return (denumerator == 0) ? constexprFailure(DIVIDE_BY_ZERO, iterations, evaluations)
+		: newtonLoop(fx, dfx, newtonRoot(x0, numerator, denumerator), relativeChange(x0, newtonRoot(x0, numerator, denumerator)), iterations + 1, evaluations);
+}
+
+template <typename F, typename DF>
+constexpr Solution newtonLoop(const F &fx, const DF &dfx, double x, double error, int iterations, int evaluations) noexcept { //Itertaions loop.
+	return (error <= EPSILON) ? constexprSolution(x, (fx(x) != 0) ? error : 0, iterations, evaluations + 1, SOLVED)
+		: (iterations > MAX_ITERATIONS) ? constexprFailure(NOT_CONVERGED, iterations, evaluations)
+		: newtonStep(fx, dfx, x, fx(x), dfx(x), iterations, evaluations + 2);
+}
+
+template <typename F, typename DF>
+constexpr Solution newtonStart(const F &fx, const DF &dfx, double x0, double numerator, double denumerator) noexcept { //Initial computation.
+	return (denumerator == 0) ? constexprFailure(DIVIDE_BY_ZERO, 0, 2)
+		: newtonLoop(fx, dfx, newtonRoot(x0, numerator, denumerator), DBL_MAX, 0, 2);
+}
+
+template <typename F, typename DF>
+constexpr Solution findRootByConstexprNewton(const F &fx, const DF &dfx, double x0) noexcept { //Computing the root using Newton-Raphson Method, at compile time when the arguments are constant.
+	return newtonStart(fx, dfx, x0, fx(x0), dfx(x0));
+}
+
+static_assert(findRootByConstexprBisection(Equation1(), 0.0, 1.0).status == SOLVED, "Equation 1 must stay solvable at compile time.");
+static_assert(findRootByConstexprNewton(Equation1(), Derivative<Equation1>(), 0.5).status == SOLVED, "Equation 1 must stay solvable at compile time.");
+
+
+//----Equations' Evaluators----------
+Formula formulae[7], //Original Equations (6 is the equation entered at the menu). 
+		dformulae[7]; //Derivatives Equations.
+map<int, Expression> userEquations; //Equations compiled at runtime, by ID.
+map<int, Polynomial> userPolynomials; //Polynomial equations defined at runtime by their coefficients, by ID.
+Polynomial polynomials[4]; //Coefficients of the polynomial equations (1-3).
+const char *equationNames[6] = { "", //Equations' menu text.
+	"x^3 - 8x^2 + 12x = 4",
+	"f(x) = -12 - 21x + 18x^2 - 2.75x^3",
+	"f(x) = 6x - 4x^2 + 0.5 x^3 - 2",
+	"ln(x^4) =  0.7",
+	"7sin(x) = e^x"
+};
+const char *statusMessages[] = { "", //Failure reasons, by SolutionStatus.
+	"No root is found between the specified boundaries or the boundaries enclose two roots.",
+	"The selected method cannot solve the selected equation or very slow.",
+	"Cannot divide by zero",
+	"Cannot evaluate the equation at an estimate (e.g. ln(0)).",
+	"Invalid equation or method ID."
+};
+
+
+int main(int argc, char **argv) {
+	initFormulae(); //Initialize Equations' Evaluators.
+
+	if (argc > 1 && strcmp(argv[1], "--batch") == 0){ //Non-interactive batch mode: --batch [input|-] [output|-] [threads].
+		ios::sync_with_stdio(false);
+		ifstream inputFile;
+		ofstream outputFile;
+		bool useInputFile = argc > 2 && strcmp(argv[2], "-") != 0;
+		bool useOutputFile = argc > 3 && strcmp(argv[3], "-") != 0;
+		int threads = (argc > 4) ? atoi(argv[4]) : (int)thread::hardware_concurrency();
+		if (useInputFile){
+			inputFile.open(argv[2]);
+			if (!inputFile){
+				cerr << "Cannot open input file " << argv[2] << endl;
+				return 1;
+			}
+		}
+		if (useOutputFile){
+			outputFile.open(argv[3]);
+			if (!outputFile){
+				cerr << "Cannot open output file " << argv[3] << endl;
+				return 1;
+			}
+		}
+		istream &input = useInputFile ? static_cast<istream &>(inputFile) : cin;
+		ostream &output = useOutputFile ? static_cast<ostream &>(outputFile) : cout;
+		return runBatch(input, output, threads);
+	}
+
+	if (argc > 1 && strcmp(argv[1], "--bench") == 0){ //Benchmark mode: --bench [points] [repeats].
+		runBenchmark(cout, (argc > 2) ? atoi(argv[2]) : 1000, (argc > 3) ? atoi(argv[3]) : 5);
+		return 0;
+	}
+
+	while (1){
+		system("cls");
+		displayEquationsMenu(); //Equation Selection Menu.
+		int selectedEquation = getSelection(1, 7); //Get Selected Equation.
+		if (selectedEquation == 7)
+			exit(0);
+		else if (selectedEquation == FIRST_USER_EQUATION){
+			string text;
+			cout << "Enter the equation in x (e.g. x^3 - 8x^2 + 12x = 4): ";
+			cin >> ws;
+			getline(cin, text);
+			try{
+				defineEquation(FIRST_USER_EQUATION, text); //Compile the entered equation.
+			} catch (invalidExpressionException &e){
+				cout << e.what() << endl;
+				system("pause");
+				continue;
+			}
+			Derivative<Expression> derivative = { userEquations[FIRST_USER_EQUATION] };
+			formulae[FIRST_USER_EQUATION] = userEquations[FIRST_USER_EQUATION];
+			dformulae[FIRST_USER_EQUATION] = derivative;
+		}
+		
+		while (1){
+			system("cls");
+			displayMethodsMenu(); //Method Selection Menu.
+			int selectedMethod = getSelection(1, 9); //Get Selected Method.
+			if (selectedMethod == 9)
+				exit(0);
+			else if (selectedMethod == SCAN && selectedEquation <= 3){
+				SolutionStatus status;
+				vector<complex<double> > roots = polynomials[selectedEquation].roots(status); //Compute every root of the polynomial.
+				if (status != SOLVED){ //Print the reason the iteration failed.
+					cout << statusMessages[status] << endl;
+				} else{
+					system("cls");
+					cout << "Roots of the selected polynomial: " << endl; //Print the results.
+					for (size_t i = 0; i < roots.size(); i++){
+						cout << "x = " << roots[i].real();
+						if (fabs(roots[i].imag()) > EPSILON * max(abs(roots[i]), 1.0))
+							cout << ((roots[i].imag() < 0) ? " - " : " + ") << fabs(roots[i].imag()) << "i";
+						cout << endl;
+					}
+				}
+
+				system("pause");
+				system("cls");
+
+				displayExitMenu(); //Next Action Menu.
+				int exitOption = getSelection(1, 3); //Get Selected Action.
+				if (exitOption == 3)
+					exit(0);
+				else if (exitOption == 2)
+					break;
+			} else if (selectedMethod == SCAN){
+				cout << "Finding all roots in an interval: " << endl;
+				vector<Solution> roots = findAllRoots(formulae[selectedEquation]); //Compute every root in the interval.
+				system("cls");
+				cout << "Roots of the selected equation in the selected interval: " << endl; //Print the results.
+				if (roots.empty())
+					cout << "No roots found." << endl;
+				for (size_t i = 0; i < roots.size(); i++)
+					cout << "x = " << roots[i].root << "  (Error: ~" << roots[i].error * 100.0 << " %)" << endl;
+
+				system("pause");
+				system("cls");
+
+				displayExitMenu(); //Next Action Menu.
+				int exitOption = getSelection(1, 3); //Get Selected Action.
+				if (exitOption == 3)
+					exit(0);
+				else if (exitOption == 2)
+					break;
+			} else if (selectedMethod != 8){
+				Solution solution = invalidProblemSolution();
+				switch (selectedMethod){
+				case BISECTION:
+					cout << "Solving using Bisection method: " << endl;
+					solution = findRootByBisection(formulae[selectedEquation]); //Compute the root using Bisection Method.
+					break;
+				case SECANT:
+					cout << "Solving using Secant Method: " << endl;
+					solution = findRootBySecant(formulae[selectedEquation]); //Compute the root using Secant Method.
+					break;
+				case FALSEP:
+					cout << "Solving using False-Position Method: " << endl;
+					solution = findRootByFalsePosition(formulae[selectedEquation]); //Compute the root using False-Position Method.
+					break;
+				case NEWTON:
+					cout << "Solving using Newton-Raphson Method: " << endl;
+					solution = findRootByNewton(formulae[selectedEquation], dformulae[selectedEquation]); //Compute the root using Newton-Raphson Method.
+					break;
+				case BRENT:
+					cout << "Solving using Brent's Method: " << endl;
+					solution = findRootByBrent(formulae[selectedEquation]); //Compute the root using Brent's Method.
+					break;
+				case HALLEY:
+					cout << "Solving using Halley's Method: " << endl;
+					solution = findRootByHalley(selectedEquation); //Compute the root using Halley's Method.
+				}
+				if (solution.status != SOLVED){ //Print the reason the method failed.
+					cout << statusMessages[solution.status] << endl;
+				} else{
+					system("cls");
+					cout << "Solution of the selected equation using the selected method is: " << endl //Print the result.
+						<< "x = " << solution.root << endl
+						<< "Error: ~" << solution.error * 100.0 << " %" << endl
+						<< "Number of iterations: " << solution.iterations << endl
+						<< "Number of function evaluations: " << solution.evaluations << endl;
+				}
+
+				system("pause");
+				system("cls");
+
+				displayExitMenu(); //Next Action Menu.
+				int exitOption = getSelection(1, 3); //Get Selected Action.
+				if (exitOption == 3)
+					exit(0);
+				else if (exitOption == 2)
+					break;
+			} else
+				break;
+		}
+	}
+	return 0;
+}
+
+void initFormulae() {
+	formulae[1] = Equation1(); //First Equation.
+	formulae[2] = Equation2(); //Second Equation.
+	formulae[3] = Equation3(); //Third Equation.
+	formulae[4] = Equation4(); //Fourth Equation.
+	formulae[5] = Equation5(); //Fifth Equation.
+
+	for (int i = 1; i <= 3; i++)
+		polynomials[i] = Polynomial(POLYNOMIAL_COEFFICIENTS[i], POLYNOMIAL_DEGREE + 1); //Polynomial Equations' Coefficients.
+
+	dformulae[1] = Derivative<Equation1>(); //First Equation Derivative.
+	dformulae[2] = Derivative<Equation2>(); //Second Equation Derivative.
+	dformulae[3] = Derivative<Equation3>(); //Third Equation Derivative.
+	dformulae[4] = Derivative<Equation4>(); //Fourth Equation Derivative.
+	dformulae[5] = Derivative<Equation5>(); //Fifth Equation Derivative.
+}
+
+void defineEquation(int id, const string &text) { //Compiling an equation and registering it under the given ID.
+	if (id < FIRST_USER_EQUATION)
+		throw invalidProblemException();
+	userEquations[id] = Expression(text);
+	userPolynomials.erase(id);
+}
+
+void definePolynomial(int id, const string &coefficients) { //Registering a polynomial equation from its coefficients, constant term first.
+	if (id < FIRST_USER_EQUATION)
+		throw invalidProblemException();
+	vector<double> terms;
+	const char *position = coefficients.c_str();
+	char *end;
+	while (1){
+		double term = strtod(position, &end);
+		if (end == position)
+			break;
+		terms.push_back(term);
+		position = end;
+	}
+	while (isspace((unsigned char)*position))
+		position++;
+	if (terms.empty() || *position != 0)
+		throw invalidExpressionException();
+	userPolynomials[id] = Polynomial(terms.data(), (int)terms.size());
+	userEquations.erase(id);
+}
+
+void displayEquationsMenu() { //Printing Equation Selection Menu.
+	cout << "Select the equation you want to solve:" << endl;
+	for (int i = 1; i < FIRST_USER_EQUATION; i++)
+		cout << i << ") " << equationNames[i] << endl;
+	cout << "6) Enter an equation." << endl
+		<< "7) Quit." << endl;
+}
+
+void displayMethodsMenu() { //Printing Method Selection Menu.
+	cout << "Select the method you want to solve with:" << endl
+		<< "1) Bisection Method." << endl
+		<< "2) Secant Method." << endl
+		<< "3) False-Position Method." << endl
+		<< "4) Newton-Raphson Method." << endl
+		<< "5) Brent's Method." << endl
+		<< "6) Halley's Method." << endl
+		<< "7) All Roots (in an Interval for Equations 4 and above)." << endl
+		<< "8) Previous Menu." << endl
+		<< "9) Quit." << endl;
+}
+
+void displayExitMenu() { //Printing Exit Menu.
+	cout << "Select one of the following actions:" << endl
+		<< "1) Solve with another method." << endl
+		<< "2) Solve another equation." << endl
+		<< "3) Quit." << endl;
+}
+
+int getSelection(int min, int max) { //Geting User Selected Option.
+	char selection = ' ';
+	bool selected = false;
+
+	while (!selected){
+		cout << "Input: ";
+		cin >> selection;
+		if (selection >= (min + 48) && selection <= (max + 48))
+			selected = true;
+		else
+			cout << "Invalid option. " << endl << selection << endl;
+	}
+
+	char buf[2];
+	buf[0] = selection;
+	buf[1] = 0;
+
+	return atoi(buf);
+}
+
+Solution failSolution(Solution solution, SolutionStatus status) noexcept { //Marking a solve as failed, keeping its iteration and evaluation counts.
+	solution.root = numeric_limits<double>::quiet_NaN();
+	solution.error = DBL_MAX;
+	solution.status = status;
+	return solution;
+}
+
+Solution invalidProblemSolution() noexcept { //Result of a request naming an unknown equation or method.
+	Solution solution;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	return failSolution(solution, INVALID_PROBLEM);
+}
+
+//The criteria below are branch-free (bitwise & and |, both quotients always computed) so that the lockstep solvers' lane loops vectorize.
+double stepError(const Tolerance &tolerance, double oldRoot, double newRoot) noexcept { //Relative change of the estimate, or the absolute change within the absolute tolerance of x = 0.
+	double step = fabs(newRoot - oldRoot), relativeStep = step / fabs(newRoot);
+	return (fabs(newRoot) > tolerance.absolute) ? relativeStep : step;
+}
+
+bool hasConverged(const Tolerance &tolerance, double oldRoot, double newRoot, double residual) noexcept { //Checking the step and residual criteria.
+	double step = fabs(newRoot - oldRoot), relativeStep = step / fabs(newRoot);
+	return (step <= tolerance.absolute)
+		| ((newRoot != 0) & (relativeStep <= tolerance.relative))
+		| ((tolerance.residual > 0) & (fabs(residual) <= tolerance.residual));
+}
+
+bool withinBudget(const Tolerance &tolerance, int iterations, int evaluations) noexcept { //Checking the iteration and evaluation budgets before another iteration.
+	return (iterations <= tolerance.maxIterations) & ((tolerance.maxEvaluations <= 0) | (evaluations < tolerance.maxEvaluations));
+}
+
+template <typename F>
+bool rootExists(const F &fx, double xl, double xh) { //Checking the Existence of root in interval for Closed Methods.
+	return (fx(xl) * fx(xh) <= 0);
+}
+
+Solution findRootByBisection(const Formula &fx) { //Computing the root using Bisection Method. 
+	double xl, xh;
+
+	do{ //Getting initial guesses.
+		cout << "Enter the lower bound guess: ";
+		cin >> xl;
+		cout << "Enter the higher bound guess: ";
+		cin >> xh;
+		if (!rootExists(fx, xl, xh))
+			cout << "No root is found between the specified boundaries or the boundaries enclose two roots." << endl;
+	} while(!rootExists(fx, xl, xh)); //Validating Existence of root between the guesses.
+
+	return findRootByBisection(fx, xl, xh);
+}
+
+Solution findRootByBisection(const Formula &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using Bisection Method from the given bounds.
+	return findRootByBisection<Formula>(fx, xl, xh, tolerance);
+}
+
+template <typename F>
+Solution findRootByBisection(const F &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using Bisection Method from the given bounds.
+	double oldRoot = 0, newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	auto evaluate = [&fx, &solution](double x) { //Counted function evaluation; a non-finite value ends the solve.
+		solution.evaluations++;
+		double value = fx(x);
+		if (!isfinite(value))
+			solution.status = DOMAIN_ERROR;
+		return value;
+	};
+
+	double fl = evaluate(xl), fh = evaluate(xh); //Endpoint values are carried across iterations.
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	if (fl * fh > 0) //Validating Existence of root between the guesses.
+		return failSolution(solution, NO_ROOT);
+	oldRoot = (xl + xh) / 2.0;
+	double fOld = evaluate(oldRoot), fNew = fOld;
+
+	int iterations = 0; //Number of iterations.
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Iterations loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		if (fl * fOld <= 0){
+			newRoot = (xl + oldRoot) / 2.0;
+		} else if (fOld * fh <= 0){ //Checking the new sub-interval.
+			newRoot = (oldRoot + xh) / 2.0;
+		} else{ //Only reachable with NaN values.
+			solution.status = DOMAIN_ERROR;
+			break;
+		}
+
+		fNew = evaluate(newRoot); //The only evaluation in the iteration.
+		if (fl * fNew <= 0){
+			xh = newRoot;
+			fh = fNew;
+		} else if (fNew * fh <= 0){
+			xl = newRoot;
+			fl = fNew;
+		} else{ //Only reachable with NaN values.
+			solution.status = DOMAIN_ERROR;
+			break;
+		}
+
+		error = stepError(tolerance, oldRoot, newRoot); //Error computation.
+		converged = hasConverged(tolerance, oldRoot, newRoot, fNew);
+
+		oldRoot = newRoot;
+		fOld = fNew;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	if (fNew != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+Solution findRootBySecant(const Formula &fx) { //Computing the root using Secant Method.
+	double x0, x1;
+
+	//Getting Initial Guesses.
+	cout << "Enter the lower bound guess: ";
+	cin >> x0;
+	cout << "Enter the higher bound guess: ";
+	cin >> x1;
+
+	return findRootBySecant(fx, x0, x1);
+}
+
+Solution findRootBySecant(const Formula &fx, double x0, double x1, const Tolerance &tolerance) noexcept { //Computing the root using Secant Method from the given guesses.
+	return findRootBySecant<Formula>(fx, x0, x1, tolerance);
+}
+
+template <typename F>
+Solution findRootBySecant(const F &fx, double x0, double x1, const Tolerance &tolerance) noexcept { //Computing the root using Secant Method from the given guesses.
+	double oldRoot0 = x0, oldRoot1 = x1, newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	auto evaluate = [&fx, &solution](double x) { //Counted function evaluation; a non-finite value ends the solve.
+		solution.evaluations++;
+		double value = fx(x);
+		if (!isfinite(value))
+			solution.status = DOMAIN_ERROR;
+		return value;
+	};
+
+	auto nextRoot = [&solution](double x0, double f0, double x1, double f1) { //Next root computation function.
+		double numerator = (x1 - x0);
+		double denumerator = f1 - f0;
+		
+		if (f1 == 0) //Exact root (e.g. a warm start on the root): staying put converges, whatever the slope.
+			return x1;
+		else if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
+			return x1;
+		else if (denumerator == 0){
+			solution.status = DIVIDE_BY_ZERO;
+			return x1;
+		}
+
+		return x1 - (f1 * (numerator / denumerator));
+	};
+
+
+	double f0 = evaluate(oldRoot0), f1 = evaluate(oldRoot1), fNew;
+	oldRoot1 = nextRoot(oldRoot0, f0, oldRoot1, f1); //Initial computation.
+	f1 = evaluate(oldRoot1);
+	int iterations = 0;
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Iterations loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		newRoot = nextRoot(oldRoot0, f0, oldRoot1, f1); //Computing next root.
+		fNew = evaluate(newRoot);
+
+		error = stepError(tolerance, oldRoot1, newRoot); //Error computation.
+		converged = hasConverged(tolerance, oldRoot1, newRoot, fNew);
+
+		oldRoot0 = oldRoot1;
+		f0 = f1;
+		oldRoot1 = newRoot;
+		f1 = fNew;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	if (f1 != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+Solution findRootByFalsePosition(const Formula &fx) { //Computing the root using False-Position Method.
+	double xl, xh;
+
+	do{ //Getting inital guesses.
+		cout << "Enter the lower bound guess: ";
+		cin >> xl;
+		cout << "Enter the higher bound guess: ";
+		cin >> xh;
+		if (!rootExists(fx, xl, xh))
+			cout << "No root is found between the specified boundaries or the boundaries enclose two roots." << endl;
+	} while (!rootExists(fx, xl, xh));
+
+	return findRootByFalsePosition(fx, xl, xh);
+}
+
+Solution findRootByFalsePosition(const Formula &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using False-Position Method from the given bounds.
+	return findRootByFalsePosition<Formula>(fx, xl, xh, tolerance);
+}
+
+template <typename F>
+Solution findRootByFalsePosition(const F &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using False-Position Method from the given bounds.
+	double oldRoot, newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	auto evaluate = [&fx, &solution](double x) { //Counted function evaluation; a non-finite value ends the solve.
+		solution.evaluations++;
+		double value = fx(x);
+		if (!isfinite(value))
+			solution.status = DOMAIN_ERROR;
+		return value;
+	};
+
+	auto nextRoot = [&solution](double x0, double f0, double x1, double f1) { //Next root computation function.
+		double numerator = (x1 - x0);
+		double denumerator = f1 - f0;
+
+		if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
+			return x1;
+		else if (denumerator == 0){
+			solution.status = DIVIDE_BY_ZERO;
+			return x1;
+		}
+
+		return x1 - (f1 * (numerator / denumerator));
+	};
+
+	double fl = evaluate(xl), fh = evaluate(xh); //Endpoint values are carried across iterations.
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	if (fl * fh > 0) //Validating Existence of root between the guesses.
+		return failSolution(solution, NO_ROOT);
+	oldRoot = nextRoot(xl, fl, xh, fh);
+	double fOld = evaluate(oldRoot), fNew = fOld;
+
+	int iterations = 0;
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Iterations loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		if (fl * fOld <= 0){ //Checking the new sub-interval.
+			newRoot = nextRoot(xl, fl, oldRoot, fOld);
+		} else if (fOld * fh <= 0){
+			newRoot = nextRoot(oldRoot, fOld, xh, fh);
+		} else{ //Only reachable with NaN values.
+			solution.status = DOMAIN_ERROR;
+			break;
+		}
+
+		fNew = evaluate(newRoot); //The only evaluation in the iteration.
+		if (fl * fNew <= 0){
+			xh = newRoot;
+			fh = fNew;
+		} else if (fNew * fh <= 0){
+			xl = newRoot;
+			fl = fNew;
+		} else{ //Only reachable with NaN values.
+			solution.status = DOMAIN_ERROR;
+			break;
+		}
+
+		error = stepError(tolerance, oldRoot, newRoot); //Error computation.
+		converged = hasConverged(tolerance, oldRoot, newRoot, fNew);
+
+		oldRoot = newRoot;
+		fOld = fNew;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	if (fNew != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+Solution findRootByNewton(const Formula &fx, const Formula &dfx) {//Computing the root using Newton-Raphson Method.
+	double x0;
+
+	//Getting the initial guess.
+	cout << "Enter the initial guess: ";
+	cin >> x0;
+
+	return findRootByNewton(fx, dfx, x0);
+}
+
+Solution findRootByNewton(const Formula &fx, const Formula &dfx, double x0, const Tolerance &tolerance) noexcept {//Computing the root using Newton-Raphson Method from the given guess.
+	return findRootByNewton<Formula, Formula>(fx, dfx, x0, tolerance);
+}
+
+template <typename F, typename DF>
+Solution findRootByNewton(const F &fx, const DF &dfx, double x0, const Tolerance &tolerance) noexcept {//Computing the root using Newton-Raphson Method from the given guess.
+	double newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	double residual = DBL_MAX; //f at the estimate the last step started from.
+	auto nextRoot = [&fx, &dfx, &solution, &residual](double x0) { //Next root computation function.
+		double numerator = fx(x0);
+		double denumerator = dfx(x0);
+		solution.evaluations += 2;
+		residual = numerator;
+
+		if (!isfinite(numerator) || !isfinite(denumerator)){
+			solution.status = DOMAIN_ERROR;
+			return x0;
+		} else if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
+			return x0;
+		else if (denumerator == 0){
+			solution.status = DIVIDE_BY_ZERO;
+			return x0;
+		}
+
+		return x0 - (numerator / denumerator);
+	};
+
+	x0 = nextRoot(x0);
+	
+
+	int iterations = 0;
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Itertaions loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		newRoot = nextRoot(x0); //Computing next root.
+
+		error = stepError(tolerance, x0, newRoot); //Error computation.
+		converged = hasConverged(tolerance, x0, newRoot, residual);
+
+		x0 = newRoot;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	solution.evaluations++;
+	if (fx(newRoot) != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+Solution findRootByBrent(const Formula &fx) { //Computing the root using Brent's Method.
+	double xl, xh;
+
+	do{ //Getting inital guesses.
+		cout << "Enter the lower bound guess: ";
+		cin >> xl;
+		cout << "Enter the higher bound guess: ";
+		cin >> xh;
+		if (!rootExists(fx, xl, xh))
+			cout << "No root is found between the specified boundaries or the boundaries enclose two roots." << endl;
+	} while (!rootExists(fx, xl, xh));
+
+	return findRootByBrent(fx, xl, xh);
+}
+
+Solution findRootByBrent(const Formula &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using Brent's Method from the given bounds.
+	return findRootByBrent<Formula>(fx, xl, xh, tolerance);
+}
+
+template <typename F>
+Solution findRootByBrent(const F &fx, double xl, double xh, const Tolerance &tolerance) noexcept { //Computing the root using Brent's Method from the given bounds.
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	auto evaluate = [&fx, &solution](double x) { //Counted function evaluation; a non-finite value ends the solve.
+		solution.evaluations++;
+		double value = fx(x);
+		if (!isfinite(value))
+			solution.status = DOMAIN_ERROR;
+		return value;
+	};
+
+	//b: best estimate, a: previous estimate, c: contrapoint keeping the root bracketed between b and c.
+	double a = xl, b = xh, c = xh, d = 0, e = 0;
+	double fa = evaluate(a), fb = evaluate(b), fc = fb;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	if (fa * fb > 0) //Validating Existence of root between the guesses.
+		return failSolution(solution, NO_ROOT);
+
+	int iterations = 0;
+	while (solution.status == SOLVED){ //Iterations loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		if ((fb > 0 && fc > 0) || (fb < 0 && fc < 0)){ //Restoring the bracket.
+			c = a;
+			fc = fa;
+			d = e = b - a;
+		}
+		if (fabs(fc) < fabs(fb)){ //Keeping the smaller residual in b.
+			a = b; b = c; c = a;
+			fa = fb; fb = fc; fc = fa;
+		}
+
+		double accuracy = 2.0 * numeric_limits<double>::epsilon() * fabs(b) + 0.5 * (tolerance.relative * fabs(b) + tolerance.absolute);
+		double middle = 0.5 * (c - b);
+		if (fabs(middle) <= accuracy || fb == 0 || fabs(fb) <= tolerance.residual){ //Converged: the bracket is within the tolerance, or the residual is.
+			solution.root = b;
+			solution.error = (fb == 0) ? 0 : (fabs(b) > tolerance.absolute) ? fabs(middle / b) : fabs(middle);
+			break;
+		}
+
+		if (fabs(e) >= accuracy && fabs(fa) > fabs(fb)){ //Trying an interpolation step.
+			double p, q, r, s = fb / fa;
+			if (a == c){ //Secant step.
+				p = 2.0 * middle * s;
+				q = 1.0 - s;
+			} else{ //Inverse quadratic interpolation step.
+				q = fa / fc;
+				r = fb / fc;
+				p = s * (2.0 * middle * q * (q - r) - (b - a) * (r - 1.0));
+				q = (q - 1.0) * (r - 1.0) * (s - 1.0);
+			}
+			if (p > 0)
+				q = -q;
+			p = fabs(p);
+
+			double limit1 = 3.0 * middle * q - fabs(accuracy * q), limit2 = fabs(e * q);
+			if (2.0 * p < ((limit1 < limit2) ? limit1 : limit2)){ //Accepting the interpolation.
+				e = d;
+				d = p / q;
+			} else{ //Falling back to bisection.
+				d = middle;
+				e = d;
+			}
+		} else{ //Bisection step.
+			d = middle;
+			e = d;
+		}
+
+		a = b;
+		fa = fb;
+		b += (fabs(d) > accuracy) ? d : ((middle > 0) ? accuracy : -accuracy);
+		fb = evaluate(b);
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	return solution;
+}
+
+template <typename F>
+Solution findRootByDualNewton(const F &fx, double x0, const Tolerance &tolerance) noexcept {//Computing the root using Newton-Raphson Method with automatic differentiation.
+	double newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	double residual = DBL_MAX; //f at the estimate the last step started from.
+	auto nextRoot = [&fx, &solution, &residual](double x0) { //Next root computation function; f and f' come from one evaluation.
+		Dual fx0 = fx(Dual(x0, 1));
+		solution.evaluations++;
+		residual = fx0.value;
+
+		if (!isfinite(fx0.value) || !isfinite(fx0.first)){
+			solution.status = DOMAIN_ERROR;
+			return x0;
+		} else if (fx0.first <= numeric_limits<double>::epsilon() && fx0.first > 0)
+			return x0;
+		else if (fx0.first == 0){
+			solution.status = DIVIDE_BY_ZERO;
+			return x0;
+		}
+
+		return x0 - (fx0.value / fx0.first);
+	};
+
+	x0 = nextRoot(x0);
+
+
+	int iterations = 0;
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Itertaions loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		newRoot = nextRoot(x0); //Computing next root.
+
+		error = stepError(tolerance, x0, newRoot); //Error computation.
+		converged = hasConverged(tolerance, x0, newRoot, residual);
+
+		x0 = newRoot;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	solution.evaluations++;
+	if (fx(newRoot) != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+Solution findRootByHalley(int equation) {//Computing the root using Halley's Method.
+	Problem problem;
+	problem.equation = equation;
+	problem.method = HALLEY;
+	problem.guess1 = 0;
+
+	//Getting the initial guess.
+	cout << "Enter the initial guess: ";
+	cin >> problem.guess0;
+
+	return solveProblem(problem);
+}
+
+template <typename F>
+Solution findRootByHalley(const F &fx, double x0, const Tolerance &tolerance) noexcept {//Computing the root using Halley's Method with automatic differentiation.
+	double newRoot = 1, error = DBL_MAX;
+	Solution solution;
+	solution.error = 0;
+	solution.iterations = 0;
+	solution.evaluations = 0;
+	solution.status = SOLVED;
+
+	double residual = DBL_MAX; //f at the estimate the last step started from.
+	auto nextRoot = [&fx, &solution, &residual](double x0) { //Next root computation function; f, f' and f'' come from one evaluation.
+		Dual fx0 = fx(Dual(x0, 1));
+		solution.evaluations++;
+		residual = fx0.value;
+		double numerator = 2 * fx0.value * fx0.first;
+		double denumerator = 2 * fx0.first * fx0.first - fx0.value * fx0.second;
+
+		if (!isfinite(numerator) || !isfinite(denumerator)){
+			solution.status = DOMAIN_ERROR;
+			return x0;
+		} else if (denumerator <= numeric_limits<double>::epsilon() && denumerator > 0)
+			return x0;
+		else if (denumerator == 0){
+			solution.status = DIVIDE_BY_ZERO;
+			return x0;
+		}
+
+		return x0 - (numerator / denumerator);
+	};
+
+	x0 = nextRoot(x0);
+
+
+	int iterations = 0;
+	bool converged = false;
+	while (!converged && solution.status == SOLVED){ //Itertaions loop.
+		if (!withinBudget(tolerance, iterations, solution.evaluations)){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		newRoot = nextRoot(x0); //Computing next root.
+
+		error = stepError(tolerance, x0, newRoot); //Error computation.
+		converged = hasConverged(tolerance, x0, newRoot, residual);
+
+		x0 = newRoot;
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = newRoot;
+	solution.evaluations++;
+	if (fx(newRoot) != 0)
+		solution.error = error;
+	else
+		solution.error = 0;
+	solution.iterations = iterations;
+	return solution;
+}
+
+template <typename F>
+int findRootsByBisection(const F &fx, const double *xl, const double *xh, Solution *solutions, int count, const Tolerance &tolerance) noexcept { //Computing many roots using Bisection Method, SIMD_LANES brackets in lockstep.
+	int failures = 0;
+
+	for (int base = 0; base < count; base += SIMD_LANES){
+		int lanes = (count - base < SIMD_LANES) ? count - base : SIMD_LANES;
+		double l[SIMD_LANES], h[SIMD_LANES], fl[SIMD_LANES], fh[SIMD_LANES],
+			oldRoot[SIMD_LANES], fOld[SIMD_LANES], newRoot[SIMD_LANES], fNew[SIMD_LANES], error[SIMD_LANES];
+		int iterations[SIMD_LANES], evaluations[SIMD_LANES], status[SIMD_LANES];
+		int active[SIMD_LANES], stepping[SIMD_LANES]; //Lane masks, int-sized to vectorize with the status and counters.
+
+		for (int k = 0; k < SIMD_LANES; k++){ //Loading the lanes (unused lanes repeat the first bracket and stay inactive).
+			int i = base + ((k < lanes) ? k : 0);
+			l[k] = xl[i];
+			h[k] = xh[i];
+		}
+		for (int k = 0; k < SIMD_LANES; k++){
+			fl[k] = fx(l[k]);
+			fh[k] = fx(h[k]);
+			oldRoot[k] = (l[k] + h[k]) / 2.0;
+		}
+		for (int k = 0; k < SIMD_LANES; k++){
+			fOld[k] = fx(oldRoot[k]);
+			fNew[k] = fOld[k];
+			newRoot[k] = 1;
+			error[k] = DBL_MAX;
+			iterations[k] = 0;
+			bool bracketed = isfinite(fl[k]) & isfinite(fh[k]) & (fl[k] * fh[k] <= 0); //The midpoint is only evaluated for valid brackets.
+			evaluations[k] = bracketed ? 3 : 2;
+			status[k] = !(isfinite(fl[k]) & isfinite(fh[k])) ? DOMAIN_ERROR : !bracketed ? NO_ROOT : !isfinite(fOld[k]) ? DOMAIN_ERROR : SOLVED; //Validating Existence of root between the guesses.
+			active[k] = (k < lanes) & (status[k] == SOLVED);
+		}
+
+		int anyActive = 1;
+		while (anyActive){ //Iterations loop, until every lane converged or failed.
+			for (int k = 0; k < SIMD_LANES; k++){ //Checking the budget, then the new sub-interval, before the step.
+				bool budget = withinBudget(tolerance, iterations[k], evaluations[k]);
+				bool lowerHalf = fl[k] * fOld[k] <= 0, selectable = lowerHalf | (fOld[k] * fh[k] <= 0);
+				status[k] = (active[k] & !budget) ? NOT_CONVERGED : (active[k] & !selectable) ? DOMAIN_ERROR : status[k];
+				stepping[k] = active[k] & budget & selectable;
+				newRoot[k] = lowerHalf ? (l[k] + oldRoot[k]) / 2.0 : (oldRoot[k] + h[k]) / 2.0;
+			}
+			for (int k = 0; k < SIMD_LANES; k++)
+				fNew[k] = stepping[k] ? fx(newRoot[k]) : fNew[k];
+
+			anyActive = 0;
+			for (int k = 0; k < SIMD_LANES; k++){ //Updating the stepping lanes only.
+				bool lower = fl[k] * fNew[k] <= 0, valid = lower | (fNew[k] * fh[k] <= 0);
+				bool update = (stepping[k] != 0) & valid; //An invalid new value ends the lane before the iteration is counted.
+				double e = stepError(tolerance, oldRoot[k], newRoot[k]); //Error computation.
+				bool converged = hasConverged(tolerance, oldRoot[k], newRoot[k], fNew[k]);
+
+				h[k] = (update & lower) ? newRoot[k] : h[k];
+				fh[k] = (update & lower) ? fNew[k] : fh[k];
+				l[k] = (update & !lower) ? newRoot[k] : l[k];
+				fl[k] = (update & !lower) ? fNew[k] : fl[k];
+				error[k] = update ? e : error[k];
+				oldRoot[k] = update ? newRoot[k] : oldRoot[k];
+				fOld[k] = update ? fNew[k] : fOld[k];
+				evaluations[k] += stepping[k] ? 1 : 0;
+				iterations[k] += update ? 1 : 0;
+
+				status[k] = (stepping[k] & !(valid & isfinite(fNew[k]))) ? DOMAIN_ERROR : status[k];
+				active[k] = update & isfinite(fNew[k]) & !converged;
+				anyActive = anyActive | active[k];
+			}
+		}
+
+		for (int k = 0; k < lanes; k++){ //Storing the lanes' solutions.
+			Solution &solution = solutions[base + k];
+			solution.root = oldRoot[k];
+			solution.error = (fOld[k] != 0) ? error[k] : 0;
+			solution.iterations = iterations[k];
+			solution.evaluations = evaluations[k];
+			solution.status = SOLVED;
+			if (status[k] != SOLVED){
+				solution = failSolution(solution, (SolutionStatus)status[k]);
+				failures++;
+			}
+		}
+	}
+	return failures;
+}
+
+template <typename F>
+int findRootsByNewton(const F &fx, const double *x0, Solution *solutions, int count, const Tolerance &tolerance) noexcept { //Computing many roots using Newton-Raphson Method with automatic differentiation, SIMD_LANES guesses in lockstep.
+	auto held = [](double value, double first) { //Lanes whose derivative is unusable keep their estimate.
+		return (!isfinite(value) | !isfinite(first)) | ((first <= numeric_limits<double>::epsilon()) & (first > 0)) | (first == 0);
+	};
+	auto outcome = [](double value, double first) { //Status of a step.
+		return !(isfinite(value) & isfinite(first)) ? DOMAIN_ERROR : (first == 0) ? DIVIDE_BY_ZERO : SOLVED;
+	};
+	int failures = 0;
+
+	for (int base = 0; base < count; base += SIMD_LANES){
+		int lanes = (count - base < SIMD_LANES) ? count - base : SIMD_LANES;
+		double x[SIMD_LANES], value[SIMD_LANES], first[SIMD_LANES], newRoot[SIMD_LANES], error[SIMD_LANES];
+		int evaluations[SIMD_LANES], status[SIMD_LANES]; //A lane's iterations are its evaluations less the initial one.
+		int stepping[SIMD_LANES]; //Lane mask, int-sized to vectorize with the status and counters.
+
+		for (int k = 0; k < SIMD_LANES; k++){ //Loading the lanes and the initial computation (unused lanes repeat the first guess and stay inactive).
+			double guess = x0[base + ((k < lanes) ? k : 0)];
+			Dual fx0 = fx(Dual(guess, 1));
+			x[k] = held(fx0.value, fx0.first) ? guess : guess - (fx0.value / fx0.first);
+			error[k] = DBL_MAX;
+			evaluations[k] = 1;
+			status[k] = outcome(fx0.value, fx0.first);
+			stepping[k] = (k < lanes) & (status[k] == SOLVED);
+		}
+
+		int anyActive = 1;
+		for (int pass = 1; anyActive; pass++){ //Iterations loop; every stepping lane has made pass evaluations and pass - 1 iterations.
+			if (!withinBudget(tolerance, pass - 1, pass)){ //Checking the budget before the step, as in the scalar loop.
+				for (int k = 0; k < SIMD_LANES; k++)
+					status[k] = (stepping[k] != 0) ? NOT_CONVERGED : status[k];
+				break;
+			}
+
+			for (int k = 0; k < SIMD_LANES; k++){ //f and f' from one evaluation for every lane; held lanes keep their estimate.
+				Dual fx0 = fx(Dual(x[k], 1));
+				value[k] = fx0.value;
+				first[k] = fx0.first;
+				newRoot[k] = held(fx0.value, fx0.first) ? x[k] : x[k] - (fx0.value / fx0.first);
+			}
+
+			anyActive = 0;
+			for (int k = 0; k < SIMD_LANES; k++){ //Next root computation, updating the stepping lanes only.
+				double e = stepError(tolerance, x[k], newRoot[k]); //Error computation.
+				bool converged = hasConverged(tolerance, x[k], newRoot[k], value[k]);
+
+				bool step = stepping[k] != 0;
+				status[k] = step ? outcome(value[k], first[k]) : status[k];
+				error[k] = step ? e : error[k];
+				x[k] = step ? newRoot[k] : x[k];
+				evaluations[k] = step ? pass + 1 : evaluations[k];
+
+				stepping[k] = step & !converged; //Failed lanes are held, so their zero step has converged.
+				anyActive = anyActive | stepping[k];
+			}
+		}
+
+		for (int k = 0; k < lanes; k++){ //Storing the lanes' solutions.
+			Solution &solution = solutions[base + k];
+			solution.root = x[k];
+			solution.iterations = evaluations[k] - 1;
+			solution.evaluations = evaluations[k];
+			solution.status = SOLVED;
+			if (status[k] != SOLVED){
+				solution = failSolution(solution, (SolutionStatus)status[k]);
+				failures++;
+			} else{
+				solution.evaluations++;
+				solution.error = (fx(x[k]) != 0) ? error[k] : 0;
+			}
+		}
+	}
+	return failures;
+}
+
+vector<Solution> findAllRoots(const Formula &fx) { //Finding all the roots in an interval.
+	double from, to;
+	int samples;
+
+	//Getting the interval.
+	cout << "Enter the start of the interval: ";
+	cin >> from;
+	cout << "Enter the end of the interval: ";
+	cin >> to;
+	cout << "Enter the number of samples: ";
+	cin >> samples;
+
+	return findAllRoots(fx, from, to, samples);
+}
+
+vector<Solution> findAllRoots(const Formula &fx, double from, double to, int samples) { //Finding all the roots in the given interval.
+	return findAllRoots<Formula>(fx, from, to, samples);
+}
+
+template <typename F>
+vector<Solution> findAllRoots(const F &fx, double from, double to, int samples) { //Finding all the roots in the given interval.
+	vector<Solution> roots;
+	if (samples < 2)
+		samples = 2;
+	if (to < from)
+		swap(from, to);
+
+	vector<double> x(samples + 1), f(samples + 1);
+	for (int i = 0; i <= samples; i++){ //Sampling the function; points where it cannot be evaluated are not finite and never bracket a root.
+		x[i] = (i == samples) ? to : from + (to - from) * i / samples;
+		f[i] = fx(x[i]);
+	}
+
+	for (int i = 0; i <= samples; i++){
+		if (f[i] == 0){ //Exact root at a sample.
+			Solution solution;
+			solution.root = x[i];
+			solution.error = 0;
+			solution.iterations = 0;
+			solution.evaluations = 1;
+			solution.status = SOLVED;
+			roots.push_back(solution);
+		} else if (i < samples && f[i] * f[i + 1] < 0){ //Sign change: single (or odd) root in the cell.
+			Solution solution = findRootByBrent(fx, x[i], x[i + 1]);
+			if (solution.status == SOLVED)
+				roots.push_back(solution);
+		} else if (i > 0 && i < samples && f[i - 1] * f[i] > 0 && f[i] * f[i + 1] > 0
+			&& fabs(f[i]) < fabs(f[i - 1]) && fabs(f[i]) <= fabs(f[i + 1])){ //Minimum of |f| without a sign change: possible double root.
+			Solution solution = findMinimumByGoldenSection(fx, x[i - 1], x[i + 1]);
+			double scale = (fabs(f[i - 1]) > fabs(f[i + 1])) ? fabs(f[i - 1]) : fabs(f[i + 1]);
+			if (solution.status == SOLVED && fabs(fx(solution.root)) <= EPSILON * scale){
+				solution.evaluations++;
+				roots.push_back(solution);
+			}
+		}
+	}
+	return roots;
+}
+
+template <typename F>
+Solution findMinimumByGoldenSection(const F &fx, double xl, double xh) noexcept { //Locating the minimum of |f| between the bounds using Golden-Section search.
+	const double ratio = (sqrt(5.0) - 1) / 2.0;
+	double x1 = xh - ratio * (xh - xl), x2 = xl + ratio * (xh - xl);
+	double f1 = fabs(fx(x1)), f2 = fabs(fx(x2)), error = DBL_MAX;
+	Solution solution;
+	solution.evaluations = 2;
+	solution.status = SOLVED;
+
+	int iterations = 0;
+	while (error > EPSILON && solution.status == SOLVED){ //Iterations loop.
+		if (iterations > MAX_ITERATIONS){
+			solution.status = NOT_CONVERGED;
+			break;
+		}
+		if (f1 < f2){ //Keeping the sub-interval that holds the smaller value.
+			xh = x2;
+			x2 = x1;
+			f2 = f1;
+			x1 = xh - ratio * (xh - xl);
+			f1 = fabs(fx(x1));
+		} else{
+			xl = x1;
+			x1 = x2;
+			f1 = f2;
+			x2 = xl + ratio * (xh - xl);
+			f2 = fabs(fx(x2));
+		}
+		solution.evaluations++;
+
+		double middle = (xl + xh) / 2.0;
+		error = (xh - xl) / ((middle != 0) ? fabs(middle) : 1.0); //Error computation.
+		iterations++;
+	}
+	solution.iterations = iterations;
+	if (solution.status != SOLVED)
+		return failSolution(solution, solution.status);
+	solution.root = (f1 < f2) ? x1 : x2;
+	solution.error = error;
+	return solution;
+}
+
+template <typename F>
+vector<Interval> findRootsByIntervalNewton(const F &fx, double from, double to, vector<Interval> *undecided, const Tolerance &tolerance) { //Isolating the roots between the bounds into intervals that each provably hold exactly one root.
+	vector<Interval> roots, boxes(1, Interval(min(from, to), max(from, to)));
+	int processed = 0;
+
+	while (!boxes.empty()){ //Branch and prune: discard boxes without roots, verify boxes with one root, bisect the rest.
+		Interval x = boxes.back();
+		boxes.pop_back();
+		if (processed++ >= tolerance.maxIterations){ //Out of budget: the remaining boxes stay undecided.
+			if (undecided)
+				undecided->push_back(x);
+			continue;
+		}
+
+		IntervalDual f = fx(IntervalDual(x, Interval(1))); //Enclosures of f and f' over the whole box.
+		if (!f.value.contains(0)) //No root in the box (also when the box is entirely outside the domain, where the enclosure is empty).
+			continue;
+		double width = tolerance.absolute + tolerance.relative * max(fabs(x.lower), fabs(x.upper));
+
+		if (!f.first.contains(0)){ //f is monotonic on the box: at most one root, which the Newton operator N(X) = m - f(m) / F'(X) keeps.
+			double m = x.middle();
+			Interval n = Interval(m) - fx(Interval(m)) / f.first; //Empty when m is outside the domain: the box is bisected instead.
+			if (!n.empty() && x.lower < n.lower && n.upper < x.upper){ //N(X) inside X: exactly one root.
+				Interval root = n, next;
+				for (int i = 0; i < tolerance.maxIterations && root.width() > width; i++){ //Contracting while the enclosure keeps shrinking.
+					m = root.middle();
+					if (!intersect(root, Interval(m) - fx(Interval(m)) / fx(IntervalDual(root, Interval(1))).first, next) || next.width() >= root.width())
+						break;
+					root = next;
+				}
+				roots.push_back(root);
+				continue;
+			}
+			if (!n.empty() && !intersect(x, n, x)) //N(X) outside X: no root.
+				continue;
+		}
+
+		double m = x.lower + ISOLATION_SPLIT * x.width();
+		if (x.width() <= width || !(x.lower < m && m < x.upper)){ //Too narrow to split (e.g. a multiple root).
+			if (undecided)
+				undecided->push_back(x);
+			continue;
+		}
+		boxes.push_back(Interval(m, x.upper));
+		boxes.push_back(Interval(x.lower, m));
+	}
+
+	auto byLower = [](const Interval &u, const Interval &v) { return u.lower < v.lower; };
+	sort(roots.begin(), roots.end(), byLower);
+	if (undecided)
+		sort(undecided->begin(), undecided->end(), byLower);
+	return roots;
+}
+
+int runIsolation(ostream &output, int equation, double from, double to, const Tolerance &tolerance) { //Printing the verified root intervals of an equation between the bounds.
+	vector<Interval> roots, undecided;
+	switch (equation){
+	case 1:
+		roots = findRootsByIntervalNewton(Equation1(), from, to, &undecided, tolerance);
+		break;
+	case 2:
+		roots = findRootsByIntervalNewton(Equation2(), from, to, &undecided, tolerance);
+		break;
+	case 3:
+		roots = findRootsByIntervalNewton(Equation3(), from, to, &undecided, tolerance);
+		break;
+	case 4:
+		roots = findRootsByIntervalNewton(Equation4(), from, to, &undecided, tolerance);
+		break;
+	case 5:
+		roots = findRootsByIntervalNewton(Equation5(), from, to, &undecided, tolerance);
+		break;
+	default:
+		map<int, Polynomial>::const_iterator polynomial = userPolynomials.find(equation);
+		if (polynomial != userPolynomials.end()){
+			roots = findRootsByIntervalNewton(polynomial->second, from, to, &undecided, tolerance);
+			break;
+		}
+		map<int, Expression>::const_iterator user = userEquations.find(equation);
+		if (user == userEquations.end()){
+			output << "failed " << statusMessages[INVALID_PROBLEM] << '\n';
+			return 1;
+		}
+		roots = findRootsByIntervalNewton(user->second, from, to, &undecided, tolerance);
+	}
+
+	output << roots.size() << ' ' << undecided.size() << '\n';
+	for (size_t i = 0; i < roots.size(); i++)
+		output << roots[i].lower << ' ' << roots[i].upper << '\n';
+	for (size_t i = 0; i < undecided.size(); i++)
+		output << "undecided " << undecided[i].lower << ' ' << undecided[i].upper << '\n';
+	return (int)undecided.size();
+}
+
+template <typename G>
+int continueRoots(const G &family, int method, const double *parameters, Solution *solutions, int count, double guess, bool extrapolate, const Tolerance &tolerance) noexcept { //Solving a family for a sequence of parameters, seeding each solve from the previous roots.
+	double previousRoot = guess, previousParameter = 0, olderRoot = guess, olderParameter = 0;
+	int solved = 0, failures = 0;
+
+	for (int i = 0; i < count; i++){
+		ParameterBinding<G> fx = { &family, parameters[i] };
+		double prediction = previousRoot;
+		if (extrapolate && solved >= 2 && previousParameter != olderParameter) //Linear extrapolation from the last two roots.
+			prediction += (previousRoot - olderRoot) * (parameters[i] - previousParameter) / (previousParameter - olderParameter);
+
+		switch (method){
+		case SECANT:
+			solutions[i] = findRootBySecant(fx, prediction, prediction + CONTINUATION_OFFSET * (fabs(prediction) + 1), tolerance);
+			break;
+		case NEWTON:
+			solutions[i] = findRootByDualNewton(fx, prediction, tolerance);
+			break;
+		case HALLEY:
+			solutions[i] = findRootByHalley(fx, prediction, tolerance);
+			break;
+		default:
+			solutions[i] = invalidProblemSolution();
+		}
+		if (solutions[i].status != SOLVED){ //The next solve keeps the last successful seeds.
+			failures++;
+			continue;
+		}
+
+		olderRoot = previousRoot;
+		olderParameter = previousParameter;
+		previousRoot = solutions[i].root;
+		previousParameter = parameters[i];
+		solved++;
+	}
+	return failures;
+}
+
+int runSweep(ostream &output, int equation, int method, double guess, double from, double to, int steps, const Tolerance &tolerance) { //Solving a user equation for p = from..to in steps intervals with continuation.
+	map<int, Expression>::const_iterator family = userEquations.find(equation);
+	if (family == userEquations.end() || steps < 0){
+		output << "failed " << statusMessages[INVALID_PROBLEM] << '\n';
+		return 1;
+	}
+
+	vector<double> parameters(steps + 1);
+	vector<Solution> solutions(steps + 1);
+	for (int i = 0; i <= steps; i++)
+		parameters[i] = (steps == 0) ? from : from + (to - from) * i / steps;
+
+	int failures = continueRoots(family->second, method, parameters.data(), solutions.data(), steps + 1, guess, true, tolerance);
+	for (int i = 0; i <= steps; i++){
+		if (solutions[i].status != SOLVED)
+			output << "failed " << statusMessages[solutions[i].status] << '\n';
+		else
+			output << solutions[i].root << ' ' << solutions[i].error << ' ' << solutions[i].iterations << ' ' << solutions[i].evaluations << '\n';
+	}
+	return failures;
+}
+
+template <typename F>
+Solution solveProblemWith(const F &fx, const Problem &problem, const Tolerance &tolerance) noexcept { //Solving a batch record with the inlined solvers.
+	switch (problem.method){
+	case BISECTION:
+		return findRootByBisection(fx, problem.guess0, problem.guess1, tolerance);
+	case SECANT:
+		return findRootBySecant(fx, problem.guess0, problem.guess1, tolerance);
+	case FALSEP:
+		return findRootByFalsePosition(fx, problem.guess0, problem.guess1, tolerance);
+	case NEWTON:
+		return findRootByDualNewton(fx, problem.guess0, tolerance);
+	case BRENT:
+		return findRootByBrent(fx, problem.guess0, problem.guess1, tolerance);
+	case HALLEY:
+		return findRootByHalley(fx, problem.guess0, tolerance);
+	default:
+		return invalidProblemSolution();
+	}
+}
+
+Solution solveProblem(const Problem &problem, const Tolerance &tolerance) noexcept { //Solving a single batch record without any console interaction.
+	switch (problem.equation){
+	case 1:
+		return solveProblemWith(Equation1(), problem, tolerance);
+	case 2:
+		return solveProblemWith(Equation2(), problem, tolerance);
+	case 3:
+		return solveProblemWith(Equation3(), problem, tolerance);
+	case 4:
+		return solveProblemWith(Equation4(), problem, tolerance);
+	case 5:
+		return solveProblemWith(Equation5(), problem, tolerance);
+	default:
+		map<int, Polynomial>::const_iterator polynomial = userPolynomials.find(problem.equation);
+		if (polynomial != userPolynomials.end())
+			return solveProblemWith(polynomial->second, problem, tolerance);
+		map<int, Expression>::const_iterator equation = userEquations.find(problem.equation);
+		if (equation == userEquations.end())
+			return invalidProblemSolution();
+		return solveProblemWith(equation->second, problem, tolerance);
+	}
+}
+
+template <typename F>
+void solveProblemsWith(const F &fx, const Problem *problems, Solution *solutions, int count, const Tolerance &tolerance) noexcept { //Solving at most SWEEP_CHUNK records of one equation and method with the lockstep solvers.
+	double guess0[SWEEP_CHUNK], guess1[SWEEP_CHUNK];
+	for (int i = 0; i < count; i++){
+		guess0[i] = problems[i].guess0;
+		guess1[i] = problems[i].guess1;
+	}
+	if (problems[0].method == BISECTION)
+		findRootsByBisection(fx, guess0, guess1, solutions, count, tolerance);
+	else
+		findRootsByNewton(fx, guess0, solutions, count, tolerance);
+}
+
+void solveProblemGroup(const Problem *problems, Solution *solutions, int count, const Tolerance &tolerance) noexcept { //Solving consecutive records sharing an equation and method.
+	if (count == 1 || (problems[0].method != BISECTION && problems[0].method != NEWTON)){ //Only these two methods have lockstep solvers.
+		for (int i = 0; i < count; i++)
+			solutions[i] = solveProblem(problems[i], tolerance);
+		return;
+	}
+	switch (problems[0].equation){
+	case 1:
+		solveProblemsWith(Equation1(), problems, solutions, count, tolerance);
+		break;
+	case 2:
+		solveProblemsWith(Equation2(), problems, solutions, count, tolerance);
+		break;
+	case 3:
+		solveProblemsWith(Equation3(), problems, solutions, count, tolerance);
+		break;
+	case 4:
+		solveProblemsWith(Equation4(), problems, solutions, count, tolerance);
+		break;
+	case 5:
+		solveProblemsWith(Equation5(), problems, solutions, count, tolerance);
+		break;
+	default:
+		map<int, Polynomial>::const_iterator polynomial = userPolynomials.find(problems[0].equation);
+		if (polynomial != userPolynomials.end()){
+			solveProblemsWith(polynomial->second, problems, solutions, count, tolerance);
+			return;
+		}
+		map<int, Expression>::const_iterator equation = userEquations.find(problems[0].equation);
+		if (equation == userEquations.end()){
+			for (int i = 0; i < count; i++)
+				solutions[i] = invalidProblemSolution();
+			return;
+		}
+		solveProblemsWith(equation->second, problems, solutions, count, tolerance);
+	}
+}
+
+bool WorkQueue::pop(int &chunk) { //Taking the newest chunk from the owner's end.
+	lock_guard<mutex> lock(guard);
+	if (chunks.empty())
+		return false;
+	chunk = chunks.back();
+	chunks.pop_back();
+	return true;
+}
+
+bool WorkQueue::steal(int &chunk) { //Taking the oldest chunk from the other end.
+	lock_guard<mutex> lock(guard);
+	if (chunks.empty())
+		return false;
+	chunk = chunks.front();
+	chunks.pop_front();
+	return true;
+}
+
+void WorkQueue::push(int chunk) {
+	lock_guard<mutex> lock(guard);
+	chunks.push_back(chunk);
+}
+
+void solveProblems(const Problem *problems, Solution *solutions, int count, int threads, const Tolerance &tolerance) { //Solving independent records on a pool of work-stealing threads.
+	int chunkCount = (count + SWEEP_CHUNK - 1) / SWEEP_CHUNK;
+	if (threads < 1)
+		threads = 1;
+	if (threads > chunkCount)
+		threads = (chunkCount > 0) ? chunkCount : 1;
+
+	auto solveChunk = [problems, solutions, count, &tolerance](int chunk) { //Each record writes only its own solution slot, keeping the input order.
+		int end = (chunk + 1) * SWEEP_CHUNK;
+		if (end > count)
+			end = count;
+		for (int i = chunk * SWEEP_CHUNK, next; i < end; i = next){ //Runs of records sharing an equation and method are solved together.
+			for (next = i + 1; next < end && problems[next].equation == problems[i].equation && problems[next].method == problems[i].method; next++);
+			solveProblemGroup(problems + i, solutions + i, next - i, tolerance);
+		}
+	};
+
+	if (threads == 1){
+		for (int chunk = 0; chunk < chunkCount; chunk++)
+			solveChunk(chunk);
+		return;
+	}
+
+	vector<WorkQueue> queues(threads);
+	for (int chunk = 0; chunk < chunkCount; chunk++) //Contiguous initial shares; stealing evens out the slow tails.
+		queues[(long long)chunk * threads / chunkCount].push(chunk);
+
+	auto worker = [&queues, &solveChunk, threads](int id) {
+		int chunk;
+		while (1){
+			bool found = queues[id].pop(chunk);
+			for (int victim = 1; !found && victim < threads; victim++)
+				found = queues[(id + victim) % threads].steal(chunk);
+			if (!found) //No chunks are ever added while solving, so every queue is drained.
+				return;
+			solveChunk(chunk);
+		}
+	};
+
+	vector<thread> pool;
+	for (int id = 1; id < threads; id++)
+		pool.push_back(thread(worker, id));
+	worker(0);
+	for (size_t i = 0; i < pool.size(); i++)
+		pool[i].join();
+}
+
+int runRoots(ostream &output, int equation) { //Printing every real and complex root of a polynomial equation (1-3 or defined by its coefficients).
+	const Polynomial *polynomial = nullptr;
+	if (equation >= 1 && equation <= 3)
+		polynomial = &polynomials[equation];
+	else{
+		map<int, Polynomial>::const_iterator user = userPolynomials.find(equation);
+		if (user != userPolynomials.end())
+			polynomial = &user->second;
+	}
+	if (!polynomial){
+		output << "failed " << statusMessages[INVALID_PROBLEM] << '\n';
+		return 1;
+	}
+
+	SolutionStatus status;
+	vector<complex<double> > roots = polynomial->roots(status);
+	if (status != SOLVED){
+		output << "failed " << statusMessages[status] << '\n';
+		return 1;
+	}
+	output << roots.size() << '\n';
+	for (size_t i = 0; i < roots.size(); i++)
+		output << roots[i].real() << ' ' << roots[i].imag() << '\n';
+	return 0;
+}
+
+int runBatch(istream &input, ostream &output, int threads) { //Solving a stream of records: "equation method guess0 guess1", "define id expression", "polynomial id c0 c1 ... cn", "sweep id method guess from to steps", "isolate equation from to", "roots equation" or "tolerance absolute relative residual iterations evaluations" per line.
+	vector<Problem> problems(BATCH_BLOCK);
+	vector<Solution> solutions(BATCH_BLOCK);
+	Tolerance tolerance = DEFAULT_TOLERANCE, nextTolerance;
+	int failures = 0;
+	string token, definition;
+
+	output << setprecision(numeric_limits<double>::digits10 + 2);
+	//Output: "root error iterations evaluations" per record, or "failed <reason>" when the record cannot be solved.
+	while (input){
+		int count = 0, definedId = 0, sweepMethod = 0, sweepSteps = 0;
+		double sweepGuess = 0, sweepFrom = 0, sweepTo = 0;
+		bool defining = false, definingPolynomial = false, sweeping = false, isolating = false, rooting = false, tolerating = false;
+		while (count < BATCH_BLOCK && input >> token){
+			if (token == "define" || token == "polynomial"){ //Definitions apply to the records after them, so the block ends here.
+				defining = (input >> definedId) && getline(input, definition);
+				definingPolynomial = token == "polynomial";
+				break;
+			}
+			if (token == "sweep"){ //Sweeps run in order after the records before them.
+				sweeping = (input >> definedId >> sweepMethod >> sweepGuess >> sweepFrom >> sweepTo >> sweepSteps) ? true : false;
+				break;
+			}
+			if (token == "isolate"){ //Isolations run in order after the records before them.
+				isolating = (input >> definedId >> sweepFrom >> sweepTo) ? true : false;
+				break;
+			}
+			if (token == "roots"){ //Polynomial roots are printed in order after the records before them.
+				rooting = (input >> definedId) ? true : false;
+				break;
+			}
+			if (token == "tolerance"){ //Stopping criteria for the records after them.
+				tolerating = (input >> nextTolerance.absolute >> nextTolerance.relative >> nextTolerance.residual
+					>> nextTolerance.maxIterations >> nextTolerance.maxEvaluations) ? true : false;
+				break;
+			}
+			char *end;
+			problems[count].equation = (int)strtol(token.c_str(), &end, 10);
+			if (*end != 0){
+				input.setstate(ios::failbit);
+				break;
+			}
+			if (!(input >> problems[count].method >> problems[count].guess0 >> problems[count].guess1))
+				break;
+			count++;
+		}
+
+		solveProblems(problems.data(), solutions.data(), count, threads, tolerance);
+
+		for (int i = 0; i < count; i++){
+			const Solution &solution = solutions[i];
+			if (solution.status == SOLVED){
+				output << solution.root << ' ' << solution.error << ' ' << solution.iterations << ' ' << solution.evaluations << '\n';
+			} else{
+				output << "failed " << statusMessages[solution.status] << '\n';
+				failures++;
+			}
+		}
+
+		if (sweeping)
+			failures += runSweep(output, definedId, sweepMethod, sweepGuess, sweepFrom, sweepTo, sweepSteps, tolerance); //One output line per parameter value.
+		if (isolating)
+			failures += runIsolation(output, definedId, sweepFrom, sweepTo, tolerance); //A count line, then one line per interval.
+		if (rooting)
+			failures += runRoots(output, definedId); //A count line, then one "real imaginary" line per root.
+		if (defining){
+			try{
+				if (definingPolynomial)
+					definePolynomial(definedId, definition); //Register the coefficients for the following records.
+				else
+					defineEquation(definedId, definition); //Compile the equation for the following records.
+			} catch (exception &e){
+				cerr << "Cannot define equation " << definedId << ": " << e.what() << endl;
+				failures++;
+			}
+		}
+		if (tolerating)
+			tolerance = nextTolerance;
+	}
+	output.flush();
+
+	if (!input.eof()){
+		cerr << "Malformed batch record." << endl;
+		return 1;
+	}
+	return failures == 0 ? 0 : 2;
+}
+
+vector<double> findBenchmarkRoots(int equation) { //Roots of a built-in equation over the benchmark grid.
+	vector<Solution> solutions;
+	switch (equation){
+	case 1:
+		solutions = findAllRoots(Equation1(), BENCH_FROM, BENCH_TO, BENCH_SAMPLES);
+		break;
+	case 2:
+		solutions = findAllRoots(Equation2(), BENCH_FROM, BENCH_TO, BENCH_SAMPLES);
+		break;
+	case 3:
+		solutions = findAllRoots(Equation3(), BENCH_FROM, BENCH_TO, BENCH_SAMPLES);
+		break;
+	case 4:
+		solutions = findAllRoots(Equation4(), BENCH_FROM, BENCH_TO, BENCH_SAMPLES);
+		break;
+	case 5:
+		solutions = findAllRoots(Equation5(), BENCH_FROM, BENCH_TO, BENCH_SAMPLES);
+		break;
+	}
+
+	vector<double> roots;
+	for (size_t i = 0; i < solutions.size(); i++)
+		roots.push_back(solutions[i].root);
+	return roots;
+}
+
+double getBenchmarkBracket(const vector<double> &roots, double x) noexcept { //Other bound of a bracket from x enclosing only the nearest root (roots in ascending order).
+	if (roots.empty())
+		return x + BENCH_WIDTH;
+
+	size_t nearest = 0;
+	for (size_t i = 1; i < roots.size(); i++)
+		if (fabs(roots[i] - x) < fabs(roots[nearest] - x))
+			nearest = i;
+
+	double reach = BENCH_WIDTH; //Stopping halfway to the next root beyond, so that the bracket has a single sign change.
+	if (roots[nearest] >= x){
+		if (nearest + 1 < roots.size() && (roots[nearest + 1] - roots[nearest]) / 2.0 < reach)
+			reach = (roots[nearest + 1] - roots[nearest]) / 2.0;
+		return roots[nearest] + reach;
+	}
+	if (nearest > 0 && (roots[nearest] - roots[nearest - 1]) / 2.0 < reach)
+		reach = (roots[nearest] - roots[nearest - 1]) / 2.0;
+	return roots[nearest] - reach;
+}
+
+void runBenchmark(ostream &output, int points, int repeats) { //Timing every method on every built-in equation over a grid of starting points.
+	const char *methodNames[] = { "", "Bisection", "Secant", "False-Position", "Newton-Raphson", "Brent", "Halley" };
+	if (points < 2)
+		points = 2;
+	if (repeats < 1)
+		repeats = 1;
+
+	output << "Grid: " << points << " starting points in [" << BENCH_FROM << ", " << BENCH_TO << "], brackets reaching up to "
+		<< BENCH_WIDTH << " past the nearest root, " << repeats << " repeat(s)." << endl;
+	output << left << setw(10) << "Equation" << setw(16) << "Method" << right << setw(12) << "ns/solve"
+		<< setw(14) << "evals/solve" << setw(12) << "iterations" << setw(12) << "converged" << setw(10) << "failed" << endl;
+
+	for (int equation = 1; equation < FIRST_USER_EQUATION; equation++){
+		vector<double> roots = findBenchmarkRoots(equation);
+		for (int method = BISECTION; method <= HALLEY; method++){
+			bool bracketing = method == BISECTION || method == FALSEP || method == BRENT; //Seeded with a bracket around a root, instead of one that usually has none.
+			long long evaluations = 0, iterations = 0;
+			int converged = 0, solves = 0;
+			volatile double sink = 0; //Keeps the solves from being optimized away.
+
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for (int repeat = 0; repeat < repeats; repeat++){
+				for (int i = 0; i < points; i++){
+					Problem problem;
+					problem.equation = equation;
+					problem.method = method;
+					problem.guess0 = BENCH_FROM + (BENCH_TO - BENCH_FROM) * i / (points - 1);
+					problem.guess1 = bracketing ? getBenchmarkBracket(roots, problem.guess0) : problem.guess0 + BENCH_WIDTH;
+					solves++;
+					Solution solution = solveProblem(problem);
+					if (solution.status == SOLVED){
+						sink = sink + solution.root;
+						evaluations += solution.evaluations;
+						iterations += solution.iterations;
+						converged++;
+					}
+				}
+			}
+			double elapsed = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+
+			output << left << setw(10) << equation << setw(16) << methodNames[method] << right << fixed << setprecision(1)
+				<< setw(12) << elapsed / solves
+				<< setw(14) << (converged ? (double)evaluations / converged : 0.0)
+				<< setw(12) << (converged ? (double)iterations / converged : 0.0)
+				<< setw(11) << 100.0 * converged / solves << "%"
+				<< setw(9) << 100.0 * (solves - converged) / solves << "%" << endl;
+		}
+	}
+	output.unsetf(ios::floatfield);
+}
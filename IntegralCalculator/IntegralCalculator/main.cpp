@@ -1,5 +1,26 @@
 ﻿#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <atomic>
 #include <exception>
+#include <cstdint>
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 using namespace std;
 
 //----Problems' IDs----------
@@ -11,6 +32,27 @@ const double EXACT_FX = 0.7912404536792011;
 const double EXACT_TEMP_INTEGRAL = 2816;
 const double EXACT_AVG = 58.66667;
 
+//----Streaming----------
+const int STREAM_BLOCK = 1 << 20; //Bytes of text samples read and parsed together.
+
+//----Run Kernels----------
+const int RUN_BLOCK = 24; //Interior samples summed together: four periods of the 1-4-2-4 and 1-3-3-2 weights, in 24 independent lanes (three AVX-512 or six AVX2 registers).
+
+//----Adaptive Quadrature----------
+const double ADAPTIVE_TOLERANCE = 1e-10; //Relative error requested by the interactive problems.
+const int ADAPTIVE_MAX_PANELS = 2000; //Gauss-Kronrod panels before giving up.
+const int ADAPTIVE_MAX_DEPTH = 50; //Adaptive Simpson bisections of a single panel.
+const int ROMBERG_MIN_LEVELS = 4; //Step halvings before the Romberg error estimate is trusted.
+const int ROMBERG_MAX_LEVELS = 25; //Step halvings before giving up (2^25 + 1 evaluations).
+
+//----Parallel Rows----------
+const int ROW_CHUNK = 64; //Rows claimed by a thread at once; their 512 bytes of results fill whole cache lines of the aligned results buffer.
+const int CACHE_LINE = 64; //Bytes per cache line, the alignment of the row results.
+
+//----Data Files----------
+const char DATA_FILE_MAGIC[4] = { 'I', 'C', 'D', 'F' };
+const int32_t UNIFORM_SPACING = 1; //Header flag: the x (and y) columns are omitted and computed from x0 + i * dx.
+
 //----Exceptions Classes----------
 class incompatibleMethodException : public exception { //Invalid method exception.
 public:
@@ -33,6 +75,20 @@ public:
 	}
 };
 
+class invalidDataFileException : public exception { //Invalid Data File Exception
+public:
+	virtual const char* what() const throw() {
+		return "The data file cannot be opened or is not a valid sample or grid file.";
+	}
+};
+
+class malformedSamplesException : public exception { //Malformed Sample Data Exception
+public:
+	virtual const char* what() const throw() {
+		return "The sample data must be one \"x y\" pair per line.";
+	}
+};
+
 
 //----Point Structs----------
 struct Point { //2D Point Struct.
@@ -48,6 +104,161 @@ struct Point3D { //3D Point Struct.
 	Point3D(double x = 0, double y = 0, double z = 0) :x(x), y(y), z(z) {}
 };
 
+//----Equally Spaced Run Structs----------
+struct RunSums { //Sums of the samples y0..yn of an equally spaced run from x = a to b.
+	double a;
+	double b;
+	long long n; //Number of intervals.
+	double ends; //y0 + yn.
+	double odd; //Interior y_i where i is odd.
+	double even; //Interior y_i where i is even.
+	double third; //Interior y_i where i is a multiple of 3.
+	RunSums() :a(0), b(0), n(0), ends(0), odd(0), even(0), third(0) {}
+};
+
+struct StreamIntegrator { //Integrating samples one at a time in O(1) memory, splitting them into runs like getIntegral.
+	RunSums run; //The open run; its last sample is (x, y) and is not in the interior sums yet.
+	RunSums corrections; //Kahan corrections of the open run's interior sums.
+	double x;
+	double y;
+	double delta; //Spacing of the open run.
+	double total; //Integral of the closed runs.
+	double totalCorrection;
+	long long samples;
+	bool compensated; //Kahan summation of the interior sums and the total.
+	StreamIntegrator(bool compensated = false) :x(0), y(0), delta(0), total(0), totalCorrection(0), samples(0), compensated(compensated) {}
+
+	void add(double nextX, double nextY); //Consuming the next sample.
+	void closeRun(); //Integrating the open run.
+	double finish(); //Closing the last run and returning the integral.
+};
+
+//----Columnar Data Structs----------
+struct SampleColumns { //Samples stored as separate x and y arrays.
+	const double *x; //nullptr when uniformly spaced.
+	const double *y;
+	double x0; //First x and spacing, used when x is nullptr.
+	double dx;
+	long long count;
+	SampleColumns(const double *x = nullptr, const double *y = nullptr, double x0 = 0, double dx = 0, long long count = 0) :x(x), y(y), x0(x0), dx(dx), count(count) {}
+};
+
+struct GridColumns { //Grid of z values stored row by row (rows of constant y), with separate x and y axes.
+	const double *x; //nx values, or nullptr when uniformly spaced.
+	const double *y; //ny values, or nullptr when uniformly spaced.
+	const double *z; //nx * ny values; z[j * nx + i] is at (x_i, y_j).
+	double x0;
+	double dx;
+	double y0;
+	double dy;
+	long long nx;
+	long long ny;
+};
+
+struct VolumeColumns { //Volume of values stored slice by slice (slices of constant z), each slice row by row.
+	const double *x; //nx values, or nullptr when uniformly spaced.
+	const double *y; //ny values, or nullptr when uniformly spaced.
+	const double *z; //nz values, or nullptr when uniformly spaced.
+	const double *values; //nx * ny * nz values; values[(k * ny + j) * nx + i] is at (x_i, y_j, z_k).
+	double x0;
+	double dx;
+	double y0;
+	double dy;
+	double z0;
+	double dz;
+	long long nx;
+	long long ny;
+	long long nz;
+};
+
+struct DataFileHeader { //Header of a binary data file, followed by the x column, the y column (grids only) and the values.
+	char magic[4]; //DATA_FILE_MAGIC.
+	int32_t dimensions; //1: samples, 2: grid, 3: volume.
+	int32_t flags; //UNIFORM_SPACING or 0.
+	int32_t reserved;
+	int64_t nx;
+	int64_t ny; //1 for samples.
+	double x0;
+	double dx;
+	double y0;
+	double dy;
+};
+static_assert(sizeof(DataFileHeader) == 64, "The data file header must be 64 bytes.");
+
+struct VolumeFileHeader { //Extra header of a volume file, right after the DataFileHeader.
+	int64_t nz;
+	double z0;
+	double dz;
+	int64_t reserved;
+};
+static_assert(sizeof(VolumeFileHeader) == 32, "The volume file header must be 32 bytes.");
+
+//----Adaptive Quadrature Structs----------
+struct Quadrature { //Result of an adaptive integration.
+	double value;
+	double error; //Estimated absolute error.
+	int evaluations;
+	int panels; //Sub-intervals in the final partition.
+	bool converged; //False when the error estimate misses the tolerance.
+	Quadrature() :value(0), error(0), evaluations(0), panels(0), converged(true) {}
+};
+
+struct Panel { //Sub-interval of a Gauss-Kronrod integration.
+	double a;
+	double b;
+	double value;
+	double error;
+};
+
+//----Problems' Integrands----------
+struct ProblemFx { //First problem's integrand, f(x) = 2*e^-1.5x.
+	double operator()(double x) const {
+		return 2 * exp(-1.5 * x);
+	}
+};
+
+//----Memory-Mapped File Class----------
+class MappedFile { //Read-only mapping of a whole file.
+public:
+	explicit MappedFile(const char *path);
+	~MappedFile();
+	const char *data() const {
+		return address;
+	}
+	size_t size() const {
+		return length;
+	}
+
+private:
+	MappedFile(const MappedFile &);
+	MappedFile &operator=(const MappedFile &);
+	const char *address;
+	size_t length;
+#ifdef _WIN32
+	HANDLE file;
+	HANDLE mapping;
+#else
+	int descriptor;
+#endif
+};
+
+//----Integration Trace Structs----------
+struct IntegrationTrace { //Observer of the integration steps; the integral functions only do arithmetic when none is given.
+	virtual void segment(const char * /*rule*/, const Point * /*points*/, int /*ni*/, int /*nf*/, double /*result*/) {} //A run integrated with a single rule.
+	virtual void row(double /*position*/) {} //Starting a row integral of a multiple integral.
+	virtual void reduction() {} //Starting the final integral of the row integrals.
+	virtual ~IntegrationTrace() {}
+};
+
+struct ConsoleTrace : IntegrationTrace { //Printing every step, as shown in the interactive STEPS section.
+	void segment(const char *rule, const Point *points, int ni, int nf, double result);
+	void row(double position);
+	void reduction();
+};
+
+const int POINT_STRIDE = sizeof(Point) / sizeof(double); //Distance between the y values of consecutive Points.
+static_assert(sizeof(Point) == 2 * sizeof(double), "Point must hold exactly x and y.");
+
 ostream &operator<<(ostream &stream, const Point &point) { //Printing 2D Point Operator.
 	stream << "(" << point.x << ", " << point.y << ")";
 	return stream;
@@ -86,15 +297,101 @@ void displayExitMenu();
 int getSelection(int min, int max);
 
 //----Integral Functions----------
-double trapezoidal(Point *points, int ni, int nf); //Computing Integral using Trapezoidal rule.
-double simpson13(Point *points, int ni, int nf); //Computing Integral using Simpson 1/3 rule.
-double simpson38(Point *points, int ni, int nf); //Computing Integral using Simpson 3/8 rule.
-double computeWithBestMethod(Point *points, int ni, int nf); //Selecting the appropriate method.
-double getIntegral(Point *points, int ni, int nf); //Getting Integral from Sample Points.
-double getMultipleIntegral(Point3D *points, int w, int h, int xi, int xf, int yi, int yf, int seg); //Getting Multiple Integral from Sample Points.
+double trapezoidal(Point *points, int ni, int nf, IntegrationTrace *trace = nullptr); //Computing Integral using Trapezoidal rule.
+double simpson13(Point *points, int ni, int nf, IntegrationTrace *trace = nullptr); //Computing Integral using Simpson 1/3 rule.
+double simpson38(Point *points, int ni, int nf, IntegrationTrace *trace = nullptr); //Computing Integral using Simpson 3/8 rule.
+double computeWithBestMethod(Point *points, int ni, int nf, IntegrationTrace *trace = nullptr); //Selecting the appropriate method.
+double getIntegral(Point *points, int ni, int nf, IntegrationTrace *trace = nullptr); //Getting Integral from Sample Points ni..nf.
+double getMultipleIntegral(Point3D *points, int nx, int ny, IntegrationTrace *trace = nullptr); //Getting Multiple Integral from an nx by ny grid of Sample Points.
+
+//----Streaming Integral Functions----------
+bool equallySpaced(double delta, double diff); //Checking whether a spacing continues a run.
+double trapezoidalRule(const RunSums &run); //Trapezoidal rule from the run's sums.
+double simpson13Rule(const RunSums &run); //Simpson 1/3 rule from the run's sums.
+double simpson38Rule(const RunSums &run); //Simpson 3/8 rule from the run's sums.
+double integrateRun(const RunSums &run, const char **rule = nullptr); //Applying the rule computeWithBestMethod selects for the run's length.
+void kahanAdd(double &sum, double &correction, double value); //Adding to a compensated sum.
+double integrateStream(istream &input, long long *samples = nullptr); //Integrating "x y" text samples without storing them.
+
+//----Adaptive Integral Functions (F: callable taking and returning double)----------
+template <typename F> Quadrature getAdaptiveSimpsonIntegral(const F &fx, double a, double b, double absolute, double relative); //Adaptive Simpson's rule.
+template <typename F> double adaptiveSimpsonStep(const F &fx, double a, double b, double fa, double fm, double fb, double whole, double tolerance, int depth, Quadrature &result);
+template <typename F> Quadrature getGaussKronrodIntegral(const F &fx, double a, double b, double absolute, double relative); //Globally adaptive Gauss-Kronrod 7-15 rule.
+template <typename F> Panel kronrodPanel(const F &fx, double a, double b); //Gauss-Kronrod 7-15 rule on a single panel.
+template <typename F> Quadrature getRombergIntegral(const F &fx, double a, double b, double absolute, double relative); //Romberg integration.
+
+//----Columnar Integral Functions----------
+template <int STRIDE> RunSums sumRun(const double *y, long long ni, long long nf, bool compensated = false); //Collecting the weighted sums of an equally spaced run.
+double getIntegral(const SampleColumns &samples, long long ni, long long nf, bool compensated = false); //Getting Integral from columnar samples.
+double *allocateRowIntegrals(vector<double> &buffer, long long rows); //Cache-line aligned results of rows integrated in parallel.
+void integrateRows(const double *x, const double *values, double x0, double dx, long long nx, long long rows, double *rowIntegrals, bool compensated, int threads); //Integrating consecutive rows of nx values along x.
+double getMultipleIntegral(const GridColumns &grid, bool compensated = false, int threads = 1); //Getting Multiple Integral over a whole grid.
+double getVolumeIntegral(const VolumeColumns &volume, bool compensated = false, int threads = 1); //Getting Triple Integral over a whole volume.
+const DataFileHeader &readDataFileHeader(const MappedFile &file, int dimensions); //Validating a mapped data file.
+SampleColumns mapSamples(const MappedFile &file); //Viewing a mapped sample file.
+GridColumns mapGrid(const MappedFile &file); //Viewing a mapped grid file.
+VolumeColumns mapVolume(const MappedFile &file); //Viewing a mapped volume file.
 
 int main(int argc, char **argv) {
 
+	if (argc > 1 && strcmp(argv[1], "--stream") == 0){ //Non-interactive streaming mode: --stream [input|-].
+		ios::sync_with_stdio(false);
+		ifstream inputFile;
+		bool useInputFile = argc > 2 && strcmp(argv[2], "-") != 0;
+		if (useInputFile){
+			inputFile.open(argv[2], ios::binary);
+			if (!inputFile){
+				cerr << "Cannot open input file " << argv[2] << endl;
+				return 1;
+			}
+		}
+		istream &input = useInputFile ? static_cast<istream &>(inputFile) : cin;
+		try{
+			long long samples;
+			double result = integrateStream(input, &samples);
+			cout << setprecision(numeric_limits<double>::digits10 + 2) << result << ' ' << samples << endl;
+		} catch (malformedSamplesException &e){
+			cerr << e.what() << endl;
+			return 1;
+		}
+		return 0;
+	}
+
+	if (argc > 2 && strcmp(argv[1], "--mapped") == 0){ //Non-interactive binary file mode: --mapped file [compensated] [threads].
+		bool compensated = false; //Kahan summation in the kernels.
+		int threads = (int)thread::hardware_concurrency();
+		for (int i = 3; i < argc; i++){
+			if (strcmp(argv[i], "compensated") == 0)
+				compensated = true;
+			else
+				threads = atoi(argv[i]);
+		}
+		try{
+			MappedFile file(argv[2]);
+			double result;
+			long long count;
+			int dimensions = readDataFileHeader(file, 0).dimensions;
+			if (dimensions == 1){
+				SampleColumns samples = mapSamples(file);
+				result = getIntegral(samples, 0, samples.count - 1, compensated);
+				count = samples.count;
+			} else if (dimensions == 2){
+				GridColumns grid = mapGrid(file);
+				result = getMultipleIntegral(grid, compensated, threads);
+				count = grid.nx * grid.ny;
+			} else{
+				VolumeColumns volume = mapVolume(file);
+				result = getVolumeIntegral(volume, compensated, threads);
+				count = volume.nx * volume.ny * volume.nz;
+			}
+			cout << setprecision(numeric_limits<double>::digits10 + 2) << result << ' ' << count << endl;
+		} catch (invalidDataFileException &e){
+			cerr << e.what() << endl;
+			return 1;
+		}
+		return 0;
+	}
+
 	while (1){
 		system("cls");
 		displayProblemsMenu(); //Problem Selection Menu.
@@ -104,11 +401,12 @@ int main(int argc, char **argv) {
 		else {
 			try{
 				double solution, error;
+				ConsoleTrace trace; //The steps are printed as they are computed.
 				system("cls");
 				cout << "----------------STEPS-----------------------" << endl;
 				switch (selectedProblem){
 				case FX: //Solving Single Integral Porblem.
-					solution = getIntegral(samplePoints, 0, 7); //Computing the Inegral.
+					solution = getIntegral(samplePoints, 0, 6, &trace); //Computing the Inegral.
 					cout << "--------------------------------------------" << endl;
 					cout << endl << "Calculated integral of the selected problem: " << solution << endl;
 					cout << "Exact integral: " << EXACT_FX << endl;
@@ -116,11 +414,23 @@ int main(int argc, char **argv) {
 						throw divideByZeroException();
 					error = (solution - EXACT_FX) / solution; // Calculating the Error.
 					if (error < 0) error *= -1;
-					cout << "Relative error: ~" << error * 100.0 << "%" << endl;
+					cout << "Relative error: ~" << error * 100.0 << "%" << endl << endl;
+
+					{
+						Quadrature simpson = getAdaptiveSimpsonIntegral(ProblemFx(), 0, 0.6, 0, ADAPTIVE_TOLERANCE); //Integrating f(x) itself instead of the samples.
+						cout << setprecision(numeric_limits<double>::digits10) << "Adaptive Simpson integral of f(x): " << simpson.value
+							<< " (" << simpson.evaluations << " evaluations, estimated error " << simpson.error << ")" << endl;
+						Quadrature adaptive = getGaussKronrodIntegral(ProblemFx(), 0, 0.6, 0, ADAPTIVE_TOLERANCE);
+						cout << "Adaptive Gauss-Kronrod integral of f(x): " << adaptive.value
+							<< " (" << adaptive.evaluations << " evaluations, estimated error " << adaptive.error << ")" << endl;
+						Quadrature romberg = getRombergIntegral(ProblemFx(), 0, 0.6, 0, ADAPTIVE_TOLERANCE);
+						cout << "Romberg integral of f(x): " << romberg.value
+							<< " (" << romberg.evaluations << " evaluations, estimated error " << romberg.error << ")" << setprecision(6) << endl;
+					}
 					break;
 
 				case TEMP: //Solving Multiple Integral Porblem.
-					solution = getMultipleIntegral(samplePoints3D, 8, 6, 0, 8, 0, 6, 2); //Computing the Inegral.
+					solution = getMultipleIntegral(samplePoints3D, 3, 3, &trace); //Computing the Inegral.
 					cout << "--------------------------------------------" << endl;
 					double averageTemp = solution / (6.0 * 8.0);
 					cout << endl << "Calculated integral of the selected problem: " << solution << endl;
@@ -193,7 +503,7 @@ int getSelection(int min, int max) { //Geting User Selected Option.
 	return atoi(buf);
 }
 
-double trapezoidal(Point *points, int ni, int nf) { //Computing Integral using Trapezoidal rule.
+double trapezoidal(Point *points, int ni, int nf, IntegrationTrace *trace) { //Computing Integral using Trapezoidal rule.
 	double result = 0;
 	if (nf - ni < 1)
 		throw incompatibleMethodException();
@@ -204,32 +514,19 @@ double trapezoidal(Point *points, int ni, int nf) { //Computing Integral using T
 	}
 
 
-	cout << "Computing the integral of the point(s) ";
-	for (int i = ni; i <= nf; i++){
-		cout << points[i];
-		if (i != nf)
-			cout << ", ";
-	}
-	cout << " using trapezoidal rule." << endl;
-
-	//Integral Computaion:
-	result = points[ni].y + points[nf].y; //f(x0) + f(xn).
-	double fmid = 0;
-	for (int i = ni + 1; i < nf; i++) //f(x_i) where i is between 0 and n.
-		fmid += points[i].y;
-	fmid *= 2;
-
-	result += fmid;
+	//Integral Computaion (one pass over the y values):
+	RunSums run = sumRun<POINT_STRIDE>(&points[0].y, ni, nf);
+	run.a = points[ni].x;
+	run.b = points[nf].x;
+	result = trapezoidalRule(run);
 
-	result /= 2 * (nf - ni); //Divide by 2n;
-	result *= (points[nf].x - points[ni].x); //Multiply by (b - a);
-
-	cout << "Computed result = " << result << endl << endl;
+	if (trace)
+		trace->segment("trapezoidal rule", points, ni, nf, result);
 	return result;
 
 }
 
-double simpson13(Point *points, int ni, int nf) { //Computing Integral using Simpson 1/3 rule.
+double simpson13(Point *points, int ni, int nf, IntegrationTrace *trace) { //Computing Integral using Simpson 1/3 rule.
 	double result = 0;
 
 	if (nf - ni < 2 || (ni - nf) % 2 != 0)
@@ -241,38 +538,18 @@ double simpson13(Point *points, int ni, int nf) { //Computing Integral using Sim
 	}
 		
 
-	cout << "Computing the integral of the point(s) ";
-	for (int i = ni; i <= nf; i++){
-		cout << points[i];
-		if (i != nf)
-			cout << ", ";
-	}
-	cout << " using Simpson's 1/3 rule." << endl;
-
-	//Integral Computaion:
-	result = points[ni].y + points[nf].y; //f(x0) + f(xn).
-
-	double fodd = 0;
-	for (int i = ni + 1; i < nf; i += 2) //f(x_i) where i is odd.
-		fodd += points[i].y;
-	fodd *= 4.0;
-
-	double feven = 0;
-	for (int i = ni + 2; i < nf; i += 2) //f(x_i) where i is even.
-		feven += points[i].y;
-	feven *= 2.0;
-
-	result += (feven + fodd);
-	
-	result /= 3.0 * (nf - ni); //Divide by 3n.
-
-	result *= (points[nf].x - points[ni].x); //Multiply by (b - a).
+	//Integral Computaion (one pass over the y values):
+	RunSums run = sumRun<POINT_STRIDE>(&points[0].y, ni, nf);
+	run.a = points[ni].x;
+	run.b = points[nf].x;
+	result = simpson13Rule(run);
 
-	cout << "Computed result = " << result << endl << endl;
+	if (trace)
+		trace->segment("Simpson's 1/3 rule", points, ni, nf, result);
 	return result;
 }
 
-double simpson38(Point *points, int ni, int nf) { //Computing Integral using Simpson 3/8 rule.
+double simpson38(Point *points, int ni, int nf, IntegrationTrace *trace) { //Computing Integral using Simpson 3/8 rule.
 	double result = 0;
 
 	if (nf - ni < 2 || (ni - nf) % 3)
@@ -283,105 +560,631 @@ double simpson38(Point *points, int ni, int nf) { //Computing Integral using Sim
 			throw unequallySpacedPointsException();
 	}
 
+	//Integral Computaion (one pass over the y values):
+	RunSums run = sumRun<POINT_STRIDE>(&points[0].y, ni, nf);
+	run.a = points[ni].x;
+	run.b = points[nf].x;
+	result = simpson38Rule(run);
+
+	if (trace)
+		trace->segment("Simpson's 3/8 rule", points, ni, nf, result);
+	return result;
+}
+
+
+double getIntegral(Point *points, int ni, int nf, IntegrationTrace *trace) { //Getting Integral from Sample Points in one pass: each equally spaced run is found once and integrated from its sums.
+	double result = 0;
+	int start = ni;
+	while (start < nf){ //Dividing the data to runs that share their end points.
+		int end = start + 1;
+		double delta = points[end].x - points[start].x;
+		while (end < nf && equallySpaced(delta, points[end + 1].x - points[end].x))
+			end++;
+
+		RunSums run; //Unequally spaced points form one-interval runs, integrated by the trapezoidal rule.
+		if (end - start == 1){
+			run.n = 1;
+			run.ends = points[start].y + points[end].y;
+		} else{ //The spacing is already checked, so the kernels are bypassed.
+			run = sumRun<POINT_STRIDE>(&points[0].y, start, end);
+		}
+		run.a = points[start].x;
+		run.b = points[end].x;
+		const char *rule;
+		double runIntegral = integrateRun(run, &rule); //Computing using the appropriate method.
+		if (trace)
+			trace->segment(rule, points, start, end, runIntegral);
+		result += runIntegral;
+		start = end;
+	}
+	return result;
+}
+
+
+double getMultipleIntegral(Point3D *points, int nx, int ny, IntegrationTrace *trace) { //Getting Multiple Integral from Sample Points stored row by row (rows of constant y).
+	vector<Point> row(nx); //Reused by every row; dense grids are integrated in place through GridColumns instead.
+	vector<Point> rowIntegrals(ny); //Integrals along the rows.
+
+	for (int j = 0; j < ny; j++){
+		const Point3D *rowStart = points + (long long)j * nx;
+		if (trace)
+			trace->row(rowStart[0].y);
+		for (int i = 0; i < nx; i++) //Collecting the points along the row at y = y_j.
+			row[i] = Point(rowStart[i].x, rowStart[i].z);
+		rowIntegrals[j] = Point(rowStart[0].y, getIntegral(row.data(), 0, nx - 1, trace)); //Computing the integral along the row.
+	}
+
+	if (trace)
+		trace->reduction();
+	return getIntegral(rowIntegrals.data(), 0, ny - 1, trace); //Integrating the row integrals across the rows.
+}
+
+double computeWithBestMethod(Point *points, int ni, int nf, IntegrationTrace *trace) { //Computing the integral using the appropriate method.
+	int size = nf - ni;
+	if (size == 1){
+		return trapezoidal(points, ni, nf, trace);
+	} else if (size % 2 == 0){
+		return simpson13(points, ni, nf, trace);
+	} else if (size % 3 == 0){
+		return simpson38(points, ni, nf, trace);
+	} else{
+		return trapezoidal(points, ni, nf, trace);
+	}
+}
+
+void ConsoleTrace::segment(const char *rule, const Point *points, int ni, int nf, double result) {
 	cout << "Computing the integral of the point(s) ";
 	for (int i = ni; i <= nf; i++){
 		cout << points[i];
 		if (i != nf)
 			cout << ", ";
 	}
-	cout << " using Simpson's 3/8 rule." << endl;
+	cout << " using " << rule << "." << endl;
+	cout << "Computed result = " << result << endl << endl;
+}
 
-	//Integral Computaion:
-	result = points[ni].y + points[nf].y; //f(x0) + f(xn).
+void ConsoleTrace::row(double position) {
+	cout << "Computing integral along y-axis at x = " << position << "." << endl;
+}
 
-	double f1 = 0;
-	for (int i = ni + 1; i < nf; i += 3) //f(x_i) where i is 1, 4, 7..
-		f1 += points[i].y;
-	f1 *= 3;
+void ConsoleTrace::reduction() {
+	cout << "Computing final integral along the x-axis." << endl;
+}
 
-	double f2 = 0;
-	for (int i = ni + 2; i < nf; i += 3) //f(x_i) where i is 2, 5, 8..
-		f2 += points[i].y;
-	f2 *= 3;
+bool equallySpaced(double delta, double diff) { //Checking whether a spacing continues a run (the test getIntegral uses).
+	double comp = diff - delta;
+	if (comp < 0)
+		comp *= -1.0;
+	return comp < numeric_limits<double>::epsilon();
+}
 
-	double f3 = 0;
-	for (int i = ni + 3; i < nf; i += 3) //f(x_i) where i is 3, 6, 9..
-		f3 += points[i].y;
-	f3 *= 2;
+double trapezoidalRule(const RunSums &run) { //h/2 * (y0 + 2y1 + 2y2 + ... + yn).
+	return (run.ends + 2.0 * (run.odd + run.even)) / (2.0 * run.n) * (run.b - run.a);
+}
 
-	
-	result += (f1 + f2 + f3);
+double simpson13Rule(const RunSums &run) { //h/3 * (y0 + 4y1 + 2y2 + 4y3 + ... + yn).
+	return (run.ends + (2.0 * run.even + 4.0 * run.odd)) / (3.0 * run.n) * (run.b - run.a);
+}
 
-	result /= 8.0; //Divide by 8.
+double simpson38Rule(const RunSums &run) { //3h/8 * (y0 + 3y1 + 3y2 + 2y3 + ... + yn).
+	return (run.ends + (3.0 * (run.odd + run.even - run.third) + 2.0 * run.third)) * 3.0 / (8.0 * run.n) * (run.b - run.a);
+}
 
-	result *= (points[nf].x - points[ni].x); //Multiply by (b - a).
+double integrateRun(const RunSums &run, const char **rule) { //Integrating an equally spaced run from its sums (rule: set to the rule's name).
+	if (run.n % 2 == 0){
+		if (rule)
+			*rule = "Simpson's 1/3 rule";
+		return simpson13Rule(run);
+	}
+	if (run.n % 3 == 0){
+		if (rule)
+			*rule = "Simpson's 3/8 rule";
+		return simpson38Rule(run);
+	}
+	if (rule)
+		*rule = "trapezoidal rule";
+	return trapezoidalRule(run);
+}
 
-	cout << "Computed result = " << result << endl << endl;
-	return result;
+void StreamIntegrator::add(double nextX, double nextY) { //Consuming the next sample.
+	if (samples++ == 0){
+		x = nextX;
+		y = nextY;
+		return;
+	}
+
+	double diff = nextX - x;
+	if (run.n > 0 && !equallySpaced(delta, diff)) //The run ends at the last sample, which also starts the next run.
+		closeRun();
+
+	if (run.n == 0){
+		run.a = x;
+		run.ends = y;
+		delta = diff;
+	} else if (compensated){ //The last sample becomes an interior point.
+		if (run.n % 2)
+			kahanAdd(run.odd, corrections.odd, y);
+		else
+			kahanAdd(run.even, corrections.even, y);
+		if (run.n % 3 == 0)
+			kahanAdd(run.third, corrections.third, y);
+	} else{
+		if (run.n % 2)
+			run.odd += y;
+		else
+			run.even += y;
+		if (run.n % 3 == 0)
+			run.third += y;
+	}
+	run.n++;
+	x = nextX;
+	y = nextY;
 }
 
+void StreamIntegrator::closeRun() { //Integrating the open run.
+	if (run.n == 0)
+		return;
+	run.b = x;
+	run.ends += y;
+	if (compensated){
+		run.odd -= corrections.odd;
+		run.even -= corrections.even;
+		run.third -= corrections.third;
+		kahanAdd(total, totalCorrection, integrateRun(run));
+	} else
+		total += integrateRun(run);
+	run = RunSums();
+	corrections = RunSums();
+}
 
-double getIntegral(Point *points, int ni, int nf) { //Getting Integral from Sample Points.
-	double result = 0;
-	int start = ni, end = start + 1;
-	while (end < nf){ //Dividing the data to intervals.
-		end = start + 1;
-		double delta = points[end].x - points[end - 1].x;
-		double diff = delta;
-		double comp = diff - delta;
-		if (comp < 0)
-			comp *= -1.0;
-		while (comp < numeric_limits<double>::epsilon()){
-			end++;
-			diff = points[end].x - points[end - 1].x;
-			comp = diff - delta;
-			if (comp < 0)
-				comp *= -1.0;		
+double StreamIntegrator::finish() { //Closing the last run and returning the integral.
+	closeRun();
+	return total - totalCorrection;
+}
+
+void kahanAdd(double &sum, double &correction, double value) { //Kahan summation step, as in the lanes of sumRun.
+	value -= correction;
+	double next = sum + value;
+	correction = (next - sum) - value;
+	sum = next;
+}
+
+double integrateStream(istream &input, long long *samples) { //Integrating "x y" text samples, parsed in STREAM_BLOCK chunks.
+	StreamIntegrator integrator;
+	vector<char> buffer(STREAM_BLOCK + 1);
+	size_t kept = 0; //Partial line carried over from the previous chunk.
+
+	while (input){
+		input.read(buffer.data() + kept, STREAM_BLOCK - kept);
+		size_t size = kept + (size_t)input.gcount();
+		size_t parsed = size;
+		if (input){ //More data follows: only whole lines are parsed now.
+			while (parsed > 0 && buffer[parsed - 1] != '\n')
+				parsed--;
+			if (parsed == 0) //A line longer than a whole chunk.
+				throw malformedSamplesException();
 		}
-		result += computeWithBestMethod(points, start, end - 1); //Computing using the appropriate method.
-		if (end != nf)
-			end--;
 
-		start = end;
-		
+		char saved = buffer[parsed];
+		buffer[parsed] = 0;
+		auto skipBlanks = [](char *position) { //Skipping the whitespace within a line (strtod would also skip line breaks).
+			while (*position != '\n' && isspace((unsigned char)*position))
+				position++;
+			return position;
+		};
+		char *position = buffer.data(), *end;
+		while (1){ //One "x y" pair per line; blank lines are skipped.
+			while (isspace((unsigned char)*position))
+				position++;
+			if (*position == 0)
+				break;
+			double x = strtod(position, &end);
+			if (end == position)
+				throw malformedSamplesException();
+			position = skipBlanks(end);
+			if (*position == '\n') //y must be on the same line as x.
+				throw malformedSamplesException();
+			double y = strtod(position, &end);
+			if (end == position)
+				throw malformedSamplesException();
+			position = skipBlanks(end);
+			if (*position != '\n' && *position != 0) //Anything but whitespace after y.
+				throw malformedSamplesException();
+			integrator.add(x, y);
+		}
+		buffer[parsed] = saved;
+
+		kept = size - parsed;
+		memmove(buffer.data(), buffer.data() + parsed, kept);
 	}
-	return result;
+
+	if (samples)
+		*samples = integrator.samples;
+	return integrator.finish();
+}
+
+template <int STRIDE>
+RunSums sumRun(const double *y, long long ni, long long nf, bool compensated) { //Collecting the weighted sums of the run y[ni..nf] (at y[i * STRIDE]) in one pass.
+	RunSums run;
+	run.n = nf - ni;
+	run.ends = y[ni * STRIDE] + y[nf * STRIDE];
+
+	const double *interior = y + (ni + 1) * STRIDE; //Interior sample i is interior[(i - 1) * STRIDE].
+	long long count = (run.n > 1) ? run.n - 1 : 0;
+	long long blocked = count - count % RUN_BLOCK;
+	double lanes[RUN_BLOCK] = { 0 }, corrections[RUN_BLOCK] = { 0 };
+	if (compensated){
+		for (long long k = 0; k < blocked; k += RUN_BLOCK){
+			for (int r = 0; r < RUN_BLOCK; r++){ //Kahan summation in every lane.
+				double value = interior[(k + r) * STRIDE] - corrections[r];
+				double sum = lanes[r] + value;
+				corrections[r] = (sum - lanes[r]) - value;
+				lanes[r] = sum;
+			}
+		}
+	} else{
+		for (long long k = 0; k < blocked; k += RUN_BLOCK){
+			for (int r = 0; r < RUN_BLOCK; r++) //No dependency between lanes, so the loop runs on whole vector registers.
+				lanes[r] += interior[(k + r) * STRIDE];
+		}
+	}
+
+	double residues[6] = { 0 }; //Interior sums by i mod 6, which fixes both weight patterns.
+	for (int r = 0; r < RUN_BLOCK; r++) //Lane r holds the samples with i = k + r + 1.
+		residues[(r + 1) % 6] += lanes[r] - corrections[r];
+	for (long long k = blocked; k < count; k++)
+		residues[(k + 1) % 6] += interior[k * STRIDE];
+
+	run.odd = residues[1] + residues[3] + residues[5];
+	run.even = residues[0] + residues[2] + residues[4];
+	run.third = residues[0] + residues[3];
+	return run;
 }
 
+double getIntegral(const SampleColumns &samples, long long ni, long long nf, bool compensated) { //Getting Integral from columnar samples.
+	if (nf <= ni)
+		return 0;
+	if (!samples.x){ //Uniform spacing: a single run, and only the y column is read.
+		RunSums run = sumRun<1>(samples.y, ni, nf, compensated);
+		run.a = samples.x0 + ni * samples.dx;
+		run.b = samples.x0 + nf * samples.dx;
+		return integrateRun(run);
+	}
 
-double getMultipleIntegral(Point3D *points, int w, int h, int xi, int xf, int yi, int yf, int seg) { //Getting Multiple Integral from Sample Points.
-	Point yIntegrals[100]; //Integrals along the y-axis.
-	double result = 0;
-	int deltax = (xf - xi) / seg;
-	int deltay = (yf - yi) / seg;
+	StreamIntegrator integrator(compensated);
+	for (long long i = ni; i <= nf; i++)
+		integrator.add(samples.x[i], samples.y[i]);
+	return integrator.finish();
+}
 
+double *allocateRowIntegrals(vector<double> &buffer, long long rows) { //Over-allocating by less than a cache line, then starting at the first line boundary (vector only guarantees 16 bytes).
+	buffer.resize(rows + CACHE_LINE / sizeof(double) - 1);
+	return (double *)(((uintptr_t)buffer.data() + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1));
+}
 
-	for (int i = 0; i <= seg; i++){
-		cout << "Computing integral along y-axis at x = " << i * deltax << "." << endl;
-		Point rowPoints[100];
-		for (int j = 0; j <= seg; j++){ //Collecting the points along the y-axis at y = i.
-			Point3D point3d = points[i * deltay + j];
-			rowPoints[j] = Point(j * deltay, point3d.z);
+void integrateRows(const double *x, const double *values, double x0, double dx, long long nx, long long rows, double *rowIntegrals, bool compensated, int threads) { //Integrating consecutive rows of nx values along x on a pool of threads.
+	long long chunkCount = (rows + ROW_CHUNK - 1) / ROW_CHUNK;
+	if (threads < 1)
+		threads = 1;
+	if (threads > chunkCount)
+		threads = (chunkCount > 0) ? (int)chunkCount : 1;
+
+	atomic<long long> nextChunk(0);
+	auto worker = [&]() { //Every row is integrated by exactly the same operations on any thread, so the results do not depend on the thread count.
+		long long chunk;
+		while ((chunk = nextChunk++) < chunkCount){
+			long long end = min((chunk + 1) * ROW_CHUNK, rows);
+			for (long long j = chunk * ROW_CHUNK; j < end; j++){
+				SampleColumns row(x, values + j * nx, x0, dx, nx);
+				rowIntegrals[j] = getIntegral(row, 0, nx - 1, compensated);
+			}
 		}
-		double rowIntegral = getIntegral(rowPoints, 0, seg); //Computing the integral along the x-axis at y = i.
-		yIntegrals[i] = Point(i * deltax, rowIntegral);
+	};
+
+	vector<thread> pool;
+	for (int id = 1; id < threads; id++)
+		pool.push_back(thread(worker));
+	worker();
+	for (size_t i = 0; i < pool.size(); i++)
+		pool[i].join();
+}
+
+double getMultipleIntegral(const GridColumns &grid, bool compensated, int threads) { //Integrating every row along x, then the row integrals along y.
+	vector<double> buffer;
+	double *rowIntegrals = allocateRowIntegrals(buffer, grid.ny);
+	integrateRows(grid.x, grid.z, grid.x0, grid.dx, grid.nx, grid.ny, rowIntegrals, compensated, threads);
+
+	SampleColumns column(grid.y, rowIntegrals, grid.y0, grid.dy, grid.ny); //The reduction runs on one thread, in order.
+	return getIntegral(column, 0, grid.ny - 1, compensated);
+}
+
+double getVolumeIntegral(const VolumeColumns &volume, bool compensated, int threads) { //Integrating every row of every slice along x, each slice's rows along y, then the slices along z.
+	vector<double> buffer, sliceIntegrals(volume.nz);
+	double *rowIntegrals = allocateRowIntegrals(buffer, volume.ny * volume.nz);
+	integrateRows(volume.x, volume.values, volume.x0, volume.dx, volume.nx, volume.ny * volume.nz, rowIntegrals, compensated, threads); //All the slices' rows share one pool.
+
+	for (long long k = 0; k < volume.nz; k++){
+		SampleColumns column(volume.y, rowIntegrals + k * volume.ny, volume.y0, volume.dy, volume.ny);
+		sliceIntegrals[k] = getIntegral(column, 0, volume.ny - 1, compensated);
 	}
 
-	cout << "Computing final integral along the x-axis." << endl;
-	result = getIntegral(yIntegrals, 0, seg); //Integrating the results along the x-axis.
+	SampleColumns column(volume.z, sliceIntegrals.data(), volume.z0, volume.dz, volume.nz);
+	return getIntegral(column, 0, volume.nz - 1, compensated);
+}
+
+#ifdef _WIN32
+MappedFile::MappedFile(const char *path) :address(nullptr), length(0), file(INVALID_HANDLE_VALUE), mapping(nullptr) {
+	file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	LARGE_INTEGER fileSize;
+	if (file == INVALID_HANDLE_VALUE || !GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0){
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+		throw invalidDataFileException();
+	}
+	length = (size_t)fileSize.QuadPart;
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping)
+		address = (const char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!address){
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		throw invalidDataFileException();
+	}
+}
+
+MappedFile::~MappedFile() {
+	UnmapViewOfFile(address);
+	CloseHandle(mapping);
+	CloseHandle(file);
+}
+#else
+MappedFile::MappedFile(const char *path) :address(nullptr), length(0), descriptor(-1) {
+	descriptor = open(path, O_RDONLY);
+	struct stat status;
+	if (descriptor < 0 || fstat(descriptor, &status) != 0 || status.st_size == 0){
+		if (descriptor >= 0)
+			close(descriptor);
+		throw invalidDataFileException();
+	}
+	length = (size_t)status.st_size;
+	void *view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	if (view == MAP_FAILED){
+		close(descriptor);
+		throw invalidDataFileException();
+	}
+	madvise(view, length, MADV_SEQUENTIAL); //The kernels read every column front to back.
+	address = (const char *)view;
+}
+
+MappedFile::~MappedFile() {
+	munmap((void *)address, length);
+	close(descriptor);
+}
+#endif
+
+const DataFileHeader &readDataFileHeader(const MappedFile &file, int dimensions) { //Validating a mapped data file (dimensions 0: any).
+	if (file.size() < sizeof(DataFileHeader))
+		throw invalidDataFileException();
+	const DataFileHeader &header = *(const DataFileHeader *)file.data();
+	if (memcmp(header.magic, DATA_FILE_MAGIC, sizeof(DATA_FILE_MAGIC)) != 0 || header.dimensions < 1 || header.dimensions > 3
+		|| (dimensions != 0 && header.dimensions != dimensions) || header.nx < 1 || header.ny < 1 || (header.dimensions == 1 && header.ny != 1))
+		throw invalidDataFileException();
+
+	uint64_t headers = sizeof(DataFileHeader), nz = 1;
+	if (header.dimensions == 3){
+		if (file.size() < sizeof(DataFileHeader) + sizeof(VolumeFileHeader))
+			throw invalidDataFileException();
+		const VolumeFileHeader &volume = *(const VolumeFileHeader *)(file.data() + sizeof(DataFileHeader));
+		if (volume.nz < 1)
+			throw invalidDataFileException();
+		headers += sizeof(VolumeFileHeader);
+		nz = (uint64_t)volume.nz;
+	}
 
+	//Bounding every count by the doubles the file holds before multiplying or adding, so that no product or sum can overflow.
+	if ((file.size() - headers) % sizeof(double) != 0)
+		throw invalidDataFileException();
+	uint64_t remaining = (file.size() - headers) / sizeof(double), nx = (uint64_t)header.nx, ny = (uint64_t)header.ny;
+	if (nx > remaining || ny > remaining / nx || nz > remaining / (nx * ny))
+		throw invalidDataFileException();
+	uint64_t values = nx * ny * nz; //At most remaining, and so is each count, which keeps the axes' sum below 3 * remaining.
+	uint64_t axes = (header.flags & UNIFORM_SPACING) ? 0 : nx + ((header.dimensions >= 2) ? ny : 0) + ((header.dimensions == 3) ? nz : 0);
+	if (axes > remaining - values || axes + values != remaining)
+		throw invalidDataFileException();
+	return header;
+}
+
+SampleColumns mapSamples(const MappedFile &file) { //Viewing a mapped sample file: x column (unless uniform), then y column.
+	const DataFileHeader &header = readDataFileHeader(file, 1);
+	const double *columns = (const double *)(file.data() + sizeof(DataFileHeader));
+	if (header.flags & UNIFORM_SPACING)
+		return SampleColumns(nullptr, columns, header.x0, header.dx, header.nx);
+	return SampleColumns(columns, columns + header.nx, 0, 0, header.nx);
+}
+
+GridColumns mapGrid(const MappedFile &file) { //Viewing a mapped grid file: x and y columns (unless uniform), then the rows of z.
+	const DataFileHeader &header = readDataFileHeader(file, 2);
+	const double *columns = (const double *)(file.data() + sizeof(DataFileHeader));
+	GridColumns grid;
+	grid.nx = header.nx;
+	grid.ny = header.ny;
+	grid.x0 = header.x0;
+	grid.dx = header.dx;
+	grid.y0 = header.y0;
+	grid.dy = header.dy;
+	if (header.flags & UNIFORM_SPACING){
+		grid.x = grid.y = nullptr;
+		grid.z = columns;
+	} else{
+		grid.x = columns;
+		grid.y = columns + grid.nx;
+		grid.z = columns + grid.nx + grid.ny;
+	}
+	return grid;
+}
+
+template <typename F>
+Quadrature getAdaptiveSimpsonIntegral(const F &fx, double a, double b, double absolute, double relative) { //Adaptive Simpson's rule: only the panels whose halves disagree are split, and every evaluation is reused by the finer level.
+	Quadrature result;
+	double m = (a + b) / 2;
+	double fa = fx(a), fm = fx(m), fb = fx(b);
+	result.evaluations = 3;
+	double whole = (b - a) / 6 * (fa + 4 * fm + fb);
+	double tolerance = max(absolute, relative * fabs(whole));
+	result.value = adaptiveSimpsonStep(fx, a, b, fa, fm, fb, whole, tolerance, ADAPTIVE_MAX_DEPTH, result);
 	return result;
 }
 
-double computeWithBestMethod(Point *points, int ni, int nf) { //Computing the integral using the appropriate method.
-	int size = nf - ni;
-	if (size == 1){
-		return trapezoidal(points, ni, nf);
-	} else if (size % 2 == 0){
-		return simpson13(points, ni, nf);
-	} else if (size % 3 == 0){
-		return simpson38(points, ni, nf);
+template <typename F>
+double adaptiveSimpsonStep(const F &fx, double a, double b, double fa, double fm, double fb, double whole, double tolerance, int depth, Quadrature &result) { //Comparing the panel's Simpson estimate with the sum of its halves.
+	double m = (a + b) / 2, lm = (a + m) / 2, rm = (m + b) / 2;
+	double flm = fx(lm), frm = fx(rm);
+	result.evaluations += 2;
+	double left = (m - a) / 6 * (fa + 4 * flm + fm), right = (b - m) / 6 * (fm + 4 * frm + fb);
+	double delta = left + right - whole;
+
+	if (fabs(delta) <= 15 * tolerance || depth <= 0 || !(a < lm && rm < b)){ //Accepted, or cannot be split further.
+		if (fabs(delta) > 15 * tolerance)
+			result.converged = false;
+		result.error += fabs(delta) / 15;
+		result.panels++;
+		return left + right + delta / 15; //Richardson extrapolation of the two estimates.
+	}
+	return adaptiveSimpsonStep(fx, a, m, fa, flm, fm, left, tolerance / 2, depth - 1, result)
+		+ adaptiveSimpsonStep(fx, m, b, fm, frm, fb, right, tolerance / 2, depth - 1, result);
+}
+
+template <typename F>
+Quadrature getGaussKronrodIntegral(const F &fx, double a, double b, double absolute, double relative) { //Globally adaptive Gauss-Kronrod 7-15 rule: the panel with the largest error estimate is bisected until the total estimate meets the tolerance.
+	Quadrature result;
+	auto smallerError = [](const Panel &u, const Panel &v) { return u.error < v.error; };
+	vector<Panel> panels(1, kronrodPanel(fx, a, b));
+	result.value = panels[0].value;
+	result.error = panels[0].error;
+
+	while (result.error > max(absolute, relative * fabs(result.value))){
+		if ((int)panels.size() >= ADAPTIVE_MAX_PANELS){
+			result.converged = false;
+			break;
+		}
+		pop_heap(panels.begin(), panels.end(), smallerError); //Worst panel to the back.
+		Panel worst = panels.back();
+		double m = (worst.a + worst.b) / 2;
+		if (!(worst.a < m && m < worst.b)){ //Too narrow to split.
+			result.converged = false;
+			break;
+		}
+		panels.back() = kronrodPanel(fx, worst.a, m);
+		push_heap(panels.begin(), panels.end(), smallerError);
+		panels.push_back(kronrodPanel(fx, m, worst.b));
+		push_heap(panels.begin(), panels.end(), smallerError);
+
+		result.value = 0;
+		result.error = 0;
+		for (size_t i = 0; i < panels.size(); i++){ //Summed afresh, so the totals never drift through cancellation.
+			result.value += panels[i].value;
+			result.error += panels[i].error;
+		}
+	}
+
+	result.panels = (int)panels.size();
+	result.evaluations = 15 * (2 * result.panels - 1);
+	return result;
+}
+
+template <typename F>
+Panel kronrodPanel(const F &fx, double a, double b) { //Gauss-Kronrod 7-15 rule; the 7 Gauss nodes are among the 15 Kronrod nodes, so the error estimate is free.
+	static const double nodes[8] = { //Kronrod nodes; the odd ones (and 0) are the Gauss nodes.
+		0.991455371120812639206854697526329, 0.949107912342758524526189684047851, 0.864864423359769072789712788640926,
+		0.741531185599394439863864773280788, 0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+		0.207784955007898467600689403773245, 0.0 };
+	static const double kronrodWeights[8] = {
+		0.022935322010529224963732008058970, 0.063092092629978553290700663189204, 0.104790010322250183839876322541518,
+		0.140653259715525918745189590510238, 0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+		0.204432940075298892414161999234649, 0.209482141084727828012999174891714 };
+	static const double gaussWeights[4] = { //For nodes 1, 3, 5 and 7.
+		0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+		0.381830050505118944950369775488975, 0.417959183673469387755102040816327 };
+
+	double center = (a + b) / 2, half = (b - a) / 2;
+	double fc = fx(center);
+	double kronrod = kronrodWeights[7] * fc, gauss = gaussWeights[3] * fc;
+	for (int i = 0; i < 7; i++){
+		double sum = fx(center - half * nodes[i]) + fx(center + half * nodes[i]);
+		kronrod += kronrodWeights[i] * sum;
+		if (i % 2)
+			gauss += gaussWeights[i / 2] * sum;
+	}
+
+	Panel panel;
+	panel.a = a;
+	panel.b = b;
+	panel.value = kronrod * half;
+	panel.error = fabs((kronrod - gauss) * half);
+	return panel;
+}
+
+template <typename F>
+Quadrature getRombergIntegral(const F &fx, double a, double b, double absolute, double relative) { //Romberg integration: trapezoidal rule with halved steps, extrapolated by Richardson's method.
+	Quadrature result;
+	vector<double> previous(1), current;
+	double h = b - a;
+	previous[0] = h / 2 * (fx(a) + fx(b)); //Trapezoidal rule with one interval.
+	result.evaluations = 2;
+	result.value = previous[0];
+	result.converged = false;
+
+	for (int level = 1; level <= ROMBERG_MAX_LEVELS; level++){
+		long long points = 1LL << (level - 1); //Only the new midpoints are evaluated; the old samples are inside previous[0].
+		h /= 2;
+		double midpoints = 0;
+		for (long long i = 0; i < points; i++)
+			midpoints += fx(a + (2 * i + 1) * h);
+		result.evaluations += (int)points;
+
+		current.assign(level + 1, 0);
+		current[0] = previous[0] / 2 + h * midpoints; //Trapezoidal rule with 2^level intervals.
+		double factor = 1;
+		for (int k = 1; k <= level; k++){ //Each column cancels the next h^2k error term.
+			factor *= 4;
+			current[k] = current[k - 1] + (current[k - 1] - previous[k - 1]) / (factor - 1);
+		}
+
+		result.value = current[level];
+		result.error = fabs(current[level] - previous[level - 1]);
+		result.panels = (int)(2 * points);
+		swap(previous, current);
+		if (level >= ROMBERG_MIN_LEVELS && result.error <= max(absolute, relative * fabs(result.value))){
+			result.converged = true;
+			break;
+		}
+	}
+	return result;
+}
+
+VolumeColumns mapVolume(const MappedFile &file) { //Viewing a mapped volume file: x, y and z columns (unless uniform), then the slices.
+	const DataFileHeader &header = readDataFileHeader(file, 3);
+	const VolumeFileHeader &extra = *(const VolumeFileHeader *)(file.data() + sizeof(DataFileHeader));
+	const double *columns = (const double *)(file.data() + sizeof(DataFileHeader) + sizeof(VolumeFileHeader));
+	VolumeColumns volume;
+	volume.nx = header.nx;
+	volume.ny = header.ny;
+	volume.nz = extra.nz;
+	volume.x0 = header.x0;
+	volume.dx = header.dx;
+	volume.y0 = header.y0;
+	volume.dy = header.dy;
+	volume.z0 = extra.z0;
+	volume.dz = extra.dz;
+	if (header.flags & UNIFORM_SPACING){
+		volume.x = volume.y = volume.z = nullptr;
+		volume.values = columns;
 	} else{
-		return trapezoidal(points, ni, nf);
+		volume.x = columns;
+		volume.y = columns + volume.nx;
+		volume.z = columns + volume.nx + volume.ny;
+		volume.values = columns + volume.nx + volume.ny + volume.nz;
 	}
-}
\ No newline at end of file
+	return volume;
+}